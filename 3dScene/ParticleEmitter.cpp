@@ -7,7 +7,9 @@ ParticleEmitter::ParticleEmitter() :
 	m_position(0, 0, 0),
 	m_vao(0), m_vbo(0), m_ibo(0),
 	m_vertexData(nullptr),
-	m_matrix(1.0f)
+	m_matrix(1.0f),
+	m_rng(hamh::ThreadRng()),
+	m_randoms(nullptr)
 {
 
 }
@@ -16,6 +18,7 @@ ParticleEmitter::~ParticleEmitter()
 {
 	delete[] m_particles;
 	delete[] m_vertexData;
+	delete[] m_randoms;
 
 	glDeleteVertexArrays(1, &m_vao);
 	glDeleteBuffers(1, &m_vbo);
@@ -32,6 +35,7 @@ void ParticleEmitter::Init(uint32_t a_maxParticles, uint32_t a_emitRate, float a
 	// Particle array
 	m_particles = new Particle[m_maxParticles];
 	m_firstDead = 0;
+	m_randoms = new float[m_maxParticles * PE_RANDOMSPERPARTICLE];
 
 	// Create array of vertices for particles
 	// 4 verts per particle for quad
@@ -95,7 +99,7 @@ void ParticleEmitter::VarInit(const ParticleEmitterDummy& dummy)
 	VarInit(dummy.m_emitRate, dummy.m_lifespanMin, dummy.m_lifespanMax, dummy.m_velocityMin, dummy.m_velocityMax, dummy.m_startSize, dummy.m_endSize, dummy.m_startColour, dummy.m_endColour);
 }
 
-void ParticleEmitter::Emit()
+void ParticleEmitter::Emit(const float* a_random)
 {
 	// only emit if there is a dead particle to use
 	if (m_firstDead >= m_maxParticles)
@@ -109,28 +113,35 @@ void ParticleEmitter::Emit()
 
 	// randomise lifespan
 	particle.lifetime = 0;
-	particle.lifespan = hamh::fRandRange(m_lifespanMin, m_lifespanMax);
+	particle.lifespan = glm::mix(m_lifespanMin, m_lifespanMax, a_random[0]);
 
 	// set start size & col
 	particle.colour = m_startColour;
 	particle.size = m_startSize;
 
-	float vel = hamh::fRandRange(m_velocityMin, m_velocityMax);
-	particle.velocity.x = hamh::fRand() * 2.0f - 1.0f;
-	particle.velocity.y = hamh::fRand() * 2.0f - 1.0f;
-	particle.velocity.z = hamh::fRand() * 2.0f - 1.0f;
+	float vel = glm::mix(m_velocityMin, m_velocityMax, a_random[1]);
+	particle.velocity.x = a_random[2] * 2.0f - 1.0f;
+	particle.velocity.y = a_random[3] * 2.0f - 1.0f;
+	particle.velocity.z = a_random[4] * 2.0f - 1.0f;
 	particle.velocity = glm::normalize(particle.velocity) * vel;
 }
 
 void ParticleEmitter::Update(float a_deltaTime, const glm::mat4& a_camTransform)
 {
-	// spawn particles
+	// spawn particles, only as many as there are dead particles to use
+	uint32_t emitCount = 0;
 	m_emitTimer += a_deltaTime;
 	while (m_emitTimer > m_emitRate)
 	{
-		Emit();
+		++emitCount;
 		m_emitTimer -= m_emitRate;
 	}
+	if (emitCount > m_maxParticles - m_firstDead)
+		emitCount = m_maxParticles - m_firstDead;
+
+	m_rng.Fill(m_randoms, emitCount * PE_RANDOMSPERPARTICLE);
+	for (uint32_t i = 0; i < emitCount; ++i)
+		Emit(m_randoms + i * PE_RANDOMSPERPARTICLE);
 
 	uint32_t quad = 0;
 
@@ -5,7 +5,10 @@
 #include <glm/ext.hpp>
 #include <gl_core_4_4.h>
 
-#include "Helpers.h"
+#include "../HamEngine/Random.h"
+
+// Random numbers each new particle uses, lifespan, speed & a direction
+constexpr static uint32_t PE_RANDOMSPERPARTICLE = 5;
 
 struct Particle
 {
@@ -60,7 +63,8 @@ public:
 	void VarInit(float a_emitRate, float a_lifetimeMin, float a_lifetimeMax, float a_velocityMin, float a_velocityMax, float a_startSize, float a_endSize, const glm::vec4& a_startCol, const glm::vec4& a_endCol);
 	void VarInit(const ParticleEmitterDummy& dummy);
 
-	void Emit();
+	// Resurrects a dead particle from PE_RANDOMSPERPARTICLE numbers in the range of 0..1
+	void Emit(const float* a_random);
 
 	void Update(float a_deltaTime, const glm::mat4& a_camTransform);
 	void Draw();
@@ -110,5 +114,9 @@ protected:
 
 	// Emitter details
 	glm::mat4		m_matrix;
+
+	// Each frame's spawns draw their numbers in one batch
+	hamh::RngBatch	m_rng;
+	float*			m_randoms;
 };
 
@@ -1,12 +1,53 @@
 #include "Barrier.h"
+#include "Decomposition.h"
+#include "Polygon.h"
 
-Barrier::Barrier(vec2 a_begin, vec2 a_end, float a_restitution, Colour a_colour) : Line(a_begin, a_end, a_restitution, a_colour)
-{
-	
-}
+#include <algorithm>
 
-void Barrier::AddPosition(const vec2& position)
+Barrier::Barrier(const vec2* a_stroke, uint32_t a_count, MaterialID a_mat, Colour a_colour) : Compound(a_stroke[0], a_mat, a_colour)
 {
-	hit = true;
-	Line::AddPosition(position);
+	assert(a_count > 0);
+
+	// Reused between barriers
+	static thread_local std::vector<vec2> s_points;
+	static thread_local ConvexPieces s_pieces;
+	static thread_local std::vector<vec2> s_local;
+	static thread_local std::vector<Rigidbody*> s_children;
+
+	decomp::SimplifyPolyline(a_stroke, a_count, BAR_TOLERANCE, s_points);
+	s_pieces.Clear();
+
+	// Loops are filled in, as long as they make a proper polygon
+	uint32_t count = (uint32_t)s_points.size();
+	if (count > 3 && distance(s_points.front(), s_points.back()) < BAR_CLOSEDISTANCE)
+	{
+		float area = decomp::SignedArea(s_points.data(), count - 1);
+		if (fabs(area) > hamh::sqr(BAR_THICKNESS) && decomp::IsSimple(s_points.data(), count - 1))
+		{
+			if (area < 0.0f)
+				std::reverse(s_points.begin(), s_points.end() - 1);
+			decomp::DecomposePolygon(s_points.data(), count - 1, MaxPolyVertexCount, s_pieces);
+		}
+	}
+
+	// Otherwise follow the line of the stroke
+	if (s_pieces.GetCount() == 0)
+		decomp::DecomposeStroke(s_points.data(), count, BAR_THICKNESS, BAR_TOLERANCE, s_pieces);
+
+	s_children.clear();
+	for (uint32_t i = 0; i < s_pieces.GetCount(); ++i)
+	{
+		const vec2* piece = s_pieces.GetPiece(i);
+		uint32_t size = s_pieces.GetPieceSize(i);
+
+		// Children sit relative to the barrier, which is anchored at the stroke's start
+		vec2 centre = decomp::Centroid(piece, size);
+
+		s_local.clear();
+		for (uint32_t v = 0; v < size; ++v)
+			s_local.push_back(piece[v] - centre);
+		s_children.push_back(new Polygon(s_local.data(), size, centre - m_position, a_mat, a_colour));
+	}
+
+	Initialise(s_children.data(), (uint32_t)s_children.size(), 0.0f);
 }
@@ -1,12 +1,24 @@
 #pragma once
-#include "Line.h"
-class Barrier : public Line
+#include "Compound.h"
+
+// Width of drawn barriers
+constexpr static float BAR_THICKNESS = 8.0f;
+// Hand wobble smoothed out of strokes, & how far a stroke may bend within one piece
+constexpr static float BAR_TOLERANCE = 3.0f;
+// Distance the mouse moves before a stroke takes another point
+constexpr static float BAR_POINTSPACING = 2.0f;
+// Longest stroke that can be drawn, later movement is ignored
+constexpr static uint32_t BAR_MAXPOINTS = 1024;
+// Strokes ending this close to where they began are closed & filled in
+constexpr static float BAR_CLOSEDISTANCE = 30.0f;
+
+// Static barrier following a drawn stroke, built from convex pieces sharing one body
+class Barrier : public Compound
 {
 public:
-	Barrier(vec2 a_begin, vec2 a_end, float a_restitution, Colour a_colour);
+	Barrier(const vec2* a_stroke, uint32_t a_count, MaterialID a_mat, Colour a_colour);
 
-	void AddPosition(const vec2& position);
+	virtual void OnImpact() { hit = true; }
 
 	bool hit = false;
 };
-
@@ -0,0 +1,34 @@
+#include "BatchColouring.h"
+
+#include <cstring>
+
+void BatchColouring::Begin(size_t bodyCount, aie::LinearArena& arena)
+{
+	m_bodyColours = arena.allocateArray<uint32_t>(bodyCount);
+	if (bodyCount)
+		memset(m_bodyColours, 0, bodyCount * sizeof(uint32_t));
+	m_batchCount = 0;
+}
+
+uint32_t BatchColouring::Assign(uint32_t bodyA, uint32_t bodyB)
+{
+	uint32_t used = 0;
+	if (bodyA != BatchNoBody)
+		used |= m_bodyColours[bodyA];
+	if (bodyB != BatchNoBody)
+		used |= m_bodyColours[bodyB];
+
+	// Lowest free colour, or the serial batch once colours run out
+	uint32_t batch = 0;
+	while (batch < MaxBatchColours - 1 && (used & (1u << batch)))
+		++batch;
+
+	if (bodyA != BatchNoBody)
+		m_bodyColours[bodyA] |= 1u << batch;
+	if (bodyB != BatchNoBody)
+		m_bodyColours[bodyB] |= 1u << batch;
+
+	if (batch + 1 > m_batchCount)
+		m_batchCount = batch + 1;
+	return batch;
+}
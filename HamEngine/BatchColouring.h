@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <LinearArena.h>
+
+// Colours available before constraints spill into the final, serially solved, batch
+const uint32_t MaxBatchColours = 32;
+// Body index used for static/kinematic bodies, which never conflict
+const uint32_t BatchNoBody = UINT32_MAX;
+
+// Greedy colouring of a constraint graph, so no two constraints in a batch share a dynamic body
+// Batches can then be solved in parallel without write conflicts
+class BatchColouring
+{
+public:
+	// Starts a new colouring pass over bodies indexed [0, bodyCount), with masks from the step arena
+	void Begin(size_t bodyCount, aie::LinearArena& arena);
+
+	// Returns the batch for a constraint between two bodies, pass BatchNoBody for bodies that aren't written
+	uint32_t Assign(uint32_t bodyA, uint32_t bodyB);
+
+	// Number of batches used so far
+	uint32_t GetBatchCount() { return m_batchCount; }
+
+	// Final batch allows shared bodies, so must be solved serially
+	bool IsSerialBatch(uint32_t batch) { return batch == MaxBatchColours - 1; }
+
+private:
+	uint32_t* m_bodyColours = nullptr;	// Bitmask of batches each body appears in
+	uint32_t m_batchCount = 0;
+};
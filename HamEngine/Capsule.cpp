@@ -0,0 +1,66 @@
+#include "Capsule.h"
+
+Capsule::Capsule(float a_halfLength, float a_radius, vec2 a_position, MaterialID a_mat, Colour a_col, vec2 a_initVelocity, float a_rotation) : Rigidbody(ShapeType::ST_CAPSULE, a_position, a_initVelocity, a_mat, a_col)
+{
+	m_halfLength = a_halfLength;
+	m_radius = a_radius;
+	m_boundingRadius = a_halfLength + a_radius;
+	ComputeMass(materials::Get(a_mat).density);
+	m_rotation = a_rotation;
+	SetOrient(a_rotation);
+}
+
+void Capsule::Draw(aie::Renderer2D* renderer)
+{
+	renderer->setRenderColour(m_colour.GetR(), m_colour.GetG(), m_colour.GetB());
+
+	vec2 axis = m_rotMatrix * vec2(m_halfLength, 0);
+	vec2 side = m_rotMatrix * vec2(0, m_radius);
+
+	// Straight sides
+	vec2 s1 = m_position + axis + side;
+	vec2 e1 = m_position - axis + side;
+	vec2 s2 = m_position + axis - side;
+	vec2 e2 = m_position - axis - side;
+	renderer->drawLine(s1.x, s1.y, e1.x, e1.y);
+	renderer->drawLine(s2.x, s2.y, e2.x, e2.y);
+
+	// Rounded ends, each a half circle of segments facing away from the centre
+	for (int end = -1; end <= 1; end += 2)
+	{
+		vec2 centre = m_position + axis * (float)end;
+		vec2 prev = centre + side;
+		for (size_t i = 1; i <= m_drawSegments; ++i)
+		{
+			float theta = pi<float>() * (float)i / (float)m_drawSegments;
+			vec2 vert = centre + side * cos(theta) + (axis / m_halfLength) * m_radius * sin(theta) * (float)end;
+			renderer->drawLine(prev.x, prev.y, vert.x, vert.y);
+			prev = vert;
+		}
+	}
+}
+
+vec2 Capsule::GetWorldSupport(const vec2& dir)
+{
+	vec2 axis = m_rotMatrix * vec2(m_halfLength, 0);
+	return dot(axis, dir) > 0.0f ? m_position + axis : m_position - axis;
+}
+
+void Capsule::ComputeMass(float density)
+{
+	// Rectangle between the end centres plus a full circle made from both ends
+	float rr = hamh::sqr(m_radius);
+	float length = 2.0f * m_halfLength;
+	float circleMass = density * pi<float>() * rr;
+	float boxMass = density * 2.0f * m_radius * length;
+	float mass = circleMass + boxMass;
+
+	// Half circles sit offset from the centre, lc is the offset of their centroids
+	float lc = 4.0f * m_radius / (3.0f * pi<float>());
+	float circleInertia = circleMass * (0.5f * rr + hamh::sqr(m_halfLength) + 2.0f * m_halfLength * lc);
+	float boxInertia = boxMass * (4.0f * rr + hamh::sqr(length)) / 12.0f;
+	float inertia = circleInertia + boxInertia;
+
+	m_massData.iMass = mass ? 1.0f / mass : 0.0f;
+	m_massData.iInertia = inertia ? 1.0f / inertia : 0.0f;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Rigidbody.h"
+
+// Line segment rounded by a radius, segment runs along the local x axis
+class Capsule : public Rigidbody
+{
+public:
+	Capsule(float a_halfLength, float a_radius, vec2 a_position, MaterialID a_mat, Colour a_col = Colour(1, 1, 1), vec2 a_initVelocity = vec2(), float a_rotation = 0.0f);
+
+	virtual void Draw(aie::Renderer2D* renderer);
+
+	float GetHalfLength() { return m_halfLength; }
+	float GetRadius() { return m_radius; }
+
+	// Core of a capsule is its segment, the radius is applied as rounding
+	virtual vec2 GetWorldSupport(const vec2& dir);
+	virtual float GetSupportRadius() { return m_radius; }
+
+
+private:
+	virtual void ComputeMass(float density);
+	virtual void ApplyOrient(float sine, float cosine) { hamh::SetRotation(m_rotMatrix, sine, cosine); }
+
+	float m_halfLength;
+	float m_radius;
+
+	mat2 m_rotMatrix;
+
+	const static size_t m_drawSegments = 8;
+};
@@ -0,0 +1,150 @@
+#include "ChunkWorld.h"
+#include "SkyClimber.h"
+
+ChunkWorld::ChunkWorld(PhysScene* a_scene, uint32_t a_seed, float a_chunkHeight, float a_width)
+{
+	m_scene = a_scene;
+	m_seed = a_seed;
+	m_chunkHeight = a_chunkHeight;
+	m_width = a_width;
+}
+
+void ChunkWorld::Update(float a_camHeight, float a_viewHeight)
+{
+	int32_t lowest = GetChunkIndex(a_camHeight - CHK_FREEZEDISTANCE);
+	int32_t highest = GetChunkIndex(a_camHeight + a_viewHeight + CHK_LOADDISTANCE);
+
+	// Bring every chunk within range into the scene
+	for (int32_t i = lowest; i <= highest; ++i)
+	{
+		auto it = m_chunks.find(i);
+		if (it == m_chunks.end())
+			Generate(i, m_chunks[i]);
+		else if (it->second.state == ChunkState::CS_FROZEN)
+			Thaw(it->second);
+	}
+
+	// Freeze chunks out of range, evicting those that have fallen well behind
+	// Evicted chunks are regenerated from the seed if the camera ever returns
+	for (auto it = m_chunks.begin(); it != m_chunks.end();)
+	{
+		if (it->first >= lowest && it->first <= highest)
+		{
+			++it;
+			continue;
+		}
+
+		if (it->second.state == ChunkState::CS_ACTIVE)
+			Freeze(it->second);
+
+		if (it->first < lowest - (int32_t)CHK_MAXFROZEN)
+			it = m_chunks.erase(it);
+		else
+			++it;
+	}
+}
+
+size_t ChunkWorld::GetActiveChunkCount()
+{
+	size_t count = 0;
+	for (auto& pair : m_chunks)
+		if (pair.second.state == ChunkState::CS_ACTIVE)
+			++count;
+	return count;
+}
+
+size_t ChunkWorld::GetFrozenChunkCount()
+{
+	return m_chunks.size() - GetActiveChunkCount();
+}
+
+void ChunkWorld::Generate(int32_t index, Chunk& chunk)
+{
+	// Each chunk draws from its own stream, so it always rebuilds identically from the seed
+	hamh::Rng rng(m_seed, (uint32_t)index);
+
+	float base = index * m_chunkHeight;
+	uint32_t slotCount = (uint32_t)(m_chunkHeight / OBS_SLOTSPACING);
+
+	// Each slot gets one spawn attempt, chance increasing with height
+	for (uint32_t i = 0; i < slotCount; ++i)
+	{
+		float slotHeight = base + i * OBS_SLOTSPACING;
+
+		float heightRatio = slotHeight / OBS_MAXSPAWNHEIGHT;
+		heightRatio = (heightRatio < 1.0f) ? heightRatio : 1.0f;
+		float spawnChance = OBS_MAXSPAWNCHANCE * heightRatio;
+
+		if (slotHeight < OBS_MINSPAWNHEIGHT || spawnChance <= rng.fRand())
+			continue;
+
+		FrozenBody record;
+		record.position = vec2(rng.RandRange(0, (int)m_width), slotHeight + rng.fRand() * OBS_SLOTSPACING);
+		// Choose between circle or box randomly, & generate random values for them
+		if (rng.fRand() < 0.5f)
+		{
+			record.shape = ShapeType::ST_SPHERE;
+			record.size = vec2(rng.RandRange(10, 50), 0);
+			record.rotation = 0.0f;
+		}
+		else
+		{
+			record.shape = ShapeType::ST_POLYGON;
+			record.size = vec2(rng.RandRange(10, 50), rng.RandRange(10, 50));
+			record.rotation = hamh::Degrees2Radians(rng.fRand() * 360.f);
+		}
+
+		chunk.records.push_back(record);
+		chunk.bodies.push_back(m_scene->AddBody(CreateBody(record)));
+	}
+	chunk.state = ChunkState::CS_ACTIVE;
+}
+
+void ChunkWorld::Freeze(Chunk& chunk)
+{
+	// Store latest transform of each body before removing it
+	for (size_t i = 0; i < chunk.bodies.size(); ++i)
+	{
+		Rigidbody* rb = chunk.bodies[i];
+		chunk.records[i].position = rb->GetPosition();
+		chunk.records[i].rotation = rb->GetOrient();
+		m_scene->DetachBody(rb);
+		m_pool.Release(rb);
+	}
+	chunk.bodies.clear();
+	chunk.state = ChunkState::CS_FROZEN;
+}
+
+void ChunkWorld::Thaw(Chunk& chunk)
+{
+	for (const FrozenBody& record : chunk.records)
+		chunk.bodies.push_back(m_scene->AddBody(CreateBody(record)));
+	chunk.state = ChunkState::CS_ACTIVE;
+}
+
+Rigidbody* ChunkWorld::CreateBody(const FrozenBody& record)
+{
+	return m_pool.Spawn(GetPrefab(record), record.position, record.rotation);
+}
+
+PrefabID ChunkWorld::GetPrefab(const FrozenBody& record)
+{
+	// Sizes are small whole numbers, so pack into a single key
+	uint32_t key = ((uint32_t)record.shape << 24) | ((uint32_t)record.size.x << 12) | (uint32_t)record.size.y;
+	auto it = m_prefabs.find(key);
+	if (it != m_prefabs.end())
+		return it->second;
+
+	static const MaterialID obsMat = materials::Register(Material(0.f, 0.95f));
+	static const Colour obsCol = Colour(1.f, 0.95f, 0.f);
+
+	Rigidbody* body;
+	if (record.shape == ShapeType::ST_SPHERE)
+		body = new Sphere(record.size.x, vec2(), obsMat, obsCol);
+	else
+		body = new Polygon(record.size.x, record.size.y, vec2(), obsMat, obsCol);
+
+	PrefabID prefab = m_pool.Register(body);
+	m_prefabs[key] = prefab;
+	return prefab;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <map>
+
+#include "PhysScene.h"
+#include "PrefabPool.h"
+
+// Compact record of a chunk body, enough to rebuild it after freezing
+struct FrozenBody
+{
+	ShapeType shape;
+	vec2 position;
+	vec2 size;			// x is radius for spheres, half extents for boxes, whole numbers
+	float rotation;
+};
+
+enum class ChunkState : uint8_t
+{
+	CS_ACTIVE,			// Bodies live in the physics scene
+	CS_FROZEN			// Bodies removed, only records kept
+};
+
+struct Chunk
+{
+	ChunkState state = ChunkState::CS_ACTIVE;
+
+	// Live bodies while active, parallel to records
+	std::vector<Rigidbody*> bodies;
+	std::vector<FrozenBody> records;
+};
+
+// Splits the climbing column into fixed-height chunks
+// Chunks ahead of the camera are generated lazily from the seed, chunks behind
+// it are frozen into records & eventually evicted, keeping the scene size constant
+class ChunkWorld
+{
+public:
+	ChunkWorld(PhysScene* a_scene, uint32_t a_seed, float a_chunkHeight, float a_width);
+
+	// Streams chunks in & out around the visible range [a_camHeight, a_camHeight + a_viewHeight]
+	void Update(float a_camHeight, float a_viewHeight);
+
+	size_t GetActiveChunkCount();
+	size_t GetFrozenChunkCount();
+
+private:
+	int32_t GetChunkIndex(float height) { return (int32_t)floor(height / m_chunkHeight); }
+
+	void Generate(int32_t index, Chunk& chunk);
+	void Freeze(Chunk& chunk);
+	void Thaw(Chunk& chunk);
+
+	Rigidbody* CreateBody(const FrozenBody& record);
+	// Prefab matching a record's shape & size, built the first time that combination is seen
+	PrefabID GetPrefab(const FrozenBody& record);
+
+	PhysScene* m_scene;
+
+	// Chunk bodies are recycled through the pool rather than deleted
+	PrefabPool m_pool;
+	std::map<uint32_t, PrefabID> m_prefabs;
+
+	uint32_t m_seed;
+	float m_chunkHeight;
+	float m_width;
+
+	std::map<int32_t, Chunk> m_chunks;
+};
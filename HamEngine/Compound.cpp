@@ -0,0 +1,174 @@
+#include "Compound.h"
+
+#include <algorithm>
+
+Compound::Compound(Rigidbody** a_children, uint32_t a_count, vec2 a_position, MaterialID a_mat, Colour a_col, vec2 a_initVelocity, float a_rotation) : Rigidbody(ShapeType::ST_COMPOUND, a_position, a_initVelocity, a_mat, a_col)
+{
+	Initialise(a_children, a_count, a_rotation);
+}
+
+Compound::Compound(vec2 a_position, MaterialID a_mat, Colour a_col) : Rigidbody(ShapeType::ST_COMPOUND, a_position, vec2(), a_mat, a_col)
+{
+
+}
+
+void Compound::Initialise(Rigidbody** a_children, uint32_t a_count, float a_rotation)
+{
+	assert(a_count > 0);
+
+	for (uint32_t i = 0; i < a_count; ++i)
+	{
+		assert(a_children[i]->GetShape() != ShapeType::ST_LINE);
+		m_children.push_back(a_children[i]);
+		m_localPositions.push_back(a_children[i]->GetPosition());
+		m_localRotations.push_back(a_children[i]->GetOrient());
+	}
+
+	// Mass also recentres children around the combined centroid
+	ComputeMass(materials::Get(m_material).density);
+
+	// Bounds of children around their local transforms
+	m_boundingRadius = 0.f;
+	for (uint32_t i = 0; i < a_count; ++i)
+		m_boundingRadius = max(m_boundingRadius, length(m_localPositions[i]) + m_children[i]->GetBoundingRadius());
+
+	std::vector<uint32_t> indices(a_count);
+	for (uint32_t i = 0; i < a_count; ++i)
+		indices[i] = i;
+	m_nodes.reserve(a_count * 2);
+	BuildHierarchy(indices.data(), a_count);
+
+	m_rotation = a_rotation;
+	SetOrient(a_rotation);
+	UpdateWorldCache();
+}
+
+Compound::~Compound()
+{
+	for (Rigidbody* child : m_children)
+		delete child;
+}
+
+void Compound::Draw(aie::Renderer2D* renderer)
+{
+	for (Rigidbody* child : m_children)
+		child->Draw(renderer);
+}
+
+vec2 Compound::GetWorldSupport(const vec2& dir)
+{
+	float bestProjection = -FLT_MAX;
+	vec2 bestPoint(0, 0);
+
+	for (Rigidbody* child : m_children)
+	{
+		// Push rounded children out by their radius
+		vec2 point = child->GetWorldSupport(dir);
+		if (child->GetSupportRadius() > 0.f)
+			point += normalize(dir) * child->GetSupportRadius();
+
+		float projection = dot(point, dir);
+		if (projection > bestProjection)
+		{
+			bestPoint = point;
+			bestProjection = projection;
+		}
+	}
+
+	return bestPoint;
+}
+
+void Compound::UpdateWorldCache()
+{
+	if (!m_cacheDirty)
+		return;
+
+	for (size_t i = 0; i < m_children.size(); ++i)
+	{
+		m_children[i]->SetPosition(m_rotMatrix * m_localPositions[i] + m_position);
+		// Children are never integrated, so their angle is set along with the shape rotation
+		m_children[i]->SetRotation(m_rotation + m_localRotations[i]);
+		m_children[i]->UpdateWorldCache();
+	}
+	m_cacheDirty = false;
+}
+
+void Compound::ComputeMass(float density)
+{
+	// Static compounds ignore their children's mass
+	if (density == 0.0f)
+	{
+		m_massData = MassData();
+		return;
+	}
+
+	// Combine child masses, weighting the centroid by each
+	float mass = 0.f;
+	vec2 centroid(0, 0);
+	for (size_t i = 0; i < m_children.size(); ++i)
+	{
+		MassData childMass = m_children[i]->GetMassData();
+		float m = childMass.iMass ? 1.0f / childMass.iMass : 0.0f;
+		mass += m;
+		centroid += m * m_localPositions[i];
+	}
+	centroid = mass ? centroid / mass : vec2(0, 0);
+
+	// Recentre children so the compound rotates about its centroid
+	for (vec2& local : m_localPositions)
+		local -= centroid;
+	m_position += centroid;
+
+	// Parallel axis theorem for each child around the new centroid
+	float inertia = 0.f;
+	for (size_t i = 0; i < m_children.size(); ++i)
+	{
+		MassData childMass = m_children[i]->GetMassData();
+		float m = childMass.iMass ? 1.0f / childMass.iMass : 0.0f;
+		float I = childMass.iInertia ? 1.0f / childMass.iInertia : 0.0f;
+		inertia += I + m * length2(m_localPositions[i]);
+	}
+
+	m_massData.iMass = mass ? 1.0f / mass : 0.0f;
+	m_massData.iInertia = inertia ? 1.0f / inertia : 0.0f;
+}
+
+uint32_t Compound::BuildHierarchy(uint32_t* indices, uint32_t count)
+{
+	uint32_t nodeIndex = (uint32_t)m_nodes.size();
+	m_nodes.push_back(ChildNode());
+
+	// Bounds of all children in this node
+	AABB bounds;
+	bounds.min = vec2(FLT_MAX, FLT_MAX);
+	bounds.max = vec2(-FLT_MAX, -FLT_MAX);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		vec2 local = m_localPositions[indices[i]];
+		float radius = m_children[indices[i]]->GetBoundingRadius();
+		bounds.min = min(bounds.min, local - vec2(radius, radius));
+		bounds.max = max(bounds.max, local + vec2(radius, radius));
+	}
+	m_nodes[nodeIndex].bounds = bounds;
+
+	if (count == 1)
+	{
+		m_nodes[nodeIndex].child = (int32_t)indices[0];
+		return nodeIndex;
+	}
+
+	// Split at the median along the longest axis
+	vec2 extents = bounds.max - bounds.min;
+	int axis = extents.x > extents.y ? 0 : 1;
+	uint32_t half = count / 2;
+	std::nth_element(indices, indices + half, indices + count, [this, axis](uint32_t lhs, uint32_t rhs)
+	{
+		return m_localPositions[lhs][axis] < m_localPositions[rhs][axis];
+	});
+
+	uint32_t left = BuildHierarchy(indices, half);
+	uint32_t right = BuildHierarchy(indices + half, count - half);
+	m_nodes[nodeIndex].left = left;
+	m_nodes[nodeIndex].right = right;
+	return nodeIndex;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Rigidbody.h"
+
+// Maximum depth of the child hierarchy, bounds the traversal stack
+const uint32_t MaxCompoundDepth = 32;
+
+// Node of a compound's child hierarchy, bounds are in compound local space
+struct ChildNode
+{
+	AABB bounds;
+	uint32_t left = 0;
+	uint32_t right = 0;
+	int32_t child = -1;		// Child index for leaves, -1 for branches
+};
+
+// Single body made from several child shapes, each with a local transform
+// Children are owned by the compound & never added to a scene themselves
+class Compound : public Rigidbody
+{
+public:
+	// Children are positioned & rotated relative to a_position, lines aren't supported as children
+	Compound(Rigidbody** a_children, uint32_t a_count, vec2 a_position, MaterialID a_mat, Colour a_col = Colour(1, 1, 1), vec2 a_initVelocity = vec2(), float a_rotation = 0.0f);
+	virtual ~Compound();
+
+	virtual void Draw(aie::Renderer2D* renderer);
+
+	uint32_t GetChildCount() { return (uint32_t)m_children.size(); }
+	Rigidbody* GetChild(uint32_t index) { return m_children[index]; }
+
+	// Support of the children's combined hull, compounds aren't convex so this is only a bound
+	virtual vec2 GetWorldSupport(const vec2& dir);
+
+
+	// Moves children to their world transforms
+	void UpdateWorldCache();
+
+	// Calls func with every child whose bounds overlap the world-space circle
+	template<typename Func>
+	void QueryChildren(const vec2& centre, float radius, Func func);
+
+protected:
+	// For subclasses that build their children first, which must then call Initialise
+	Compound(vec2 a_position, MaterialID a_mat, Colour a_col);
+	void Initialise(Rigidbody** a_children, uint32_t a_count, float a_rotation);
+
+private:
+	virtual void ComputeMass(float density);
+	virtual void ApplyOrient(float sine, float cosine) { hamh::SetRotation(m_rotMatrix, sine, cosine); m_cacheDirty = true; }
+
+	uint32_t BuildHierarchy(uint32_t* indices, uint32_t count);
+
+	std::vector<Rigidbody*> m_children;
+	std::vector<vec2> m_localPositions;
+	std::vector<float> m_localRotations;
+
+	std::vector<ChildNode> m_nodes;
+
+	mat2 m_rotMatrix;
+};
+
+template<typename Func>
+void Compound::QueryChildren(const vec2& centre, float radius, Func func)
+{
+	// Query in local space, as the hierarchy never needs rebuilding that way
+	vec2 local = transpose(m_rotMatrix) * (centre - m_position);
+
+	uint32_t stack[MaxCompoundDepth];
+	uint32_t stackCount = 0;
+	stack[stackCount++] = 0;
+
+	while (stackCount)
+	{
+		const ChildNode& node = m_nodes[stack[--stackCount]];
+
+		// Circle against box, via closest point on the box
+		vec2 closest = clamp(local, node.bounds.min, node.bounds.max);
+		if (distance2(closest, local) > hamh::sqr(radius))
+			continue;
+
+		if (node.child >= 0)
+			func(m_children[node.child]);
+		else
+		{
+			stack[stackCount++] = node.left;
+			stack[stackCount++] = node.right;
+		}
+	}
+}
@@ -0,0 +1,408 @@
+#include "Decomposition.h"
+
+namespace
+{
+	// Twice the signed area of the triangle, positive when c is left of a -> b
+	float TriArea(const vec2& a, const vec2& b, const vec2& c)
+	{
+		return cross(b - a, c - a);
+	}
+
+	bool Left(const vec2& a, const vec2& b, const vec2& c) { return TriArea(a, b, c) > 0.0f; }
+	bool LeftOn(const vec2& a, const vec2& b, const vec2& c) { return TriArea(a, b, c) >= 0.0f; }
+	bool Right(const vec2& a, const vec2& b, const vec2& c) { return TriArea(a, b, c) < 0.0f; }
+	bool RightOn(const vec2& a, const vec2& b, const vec2& c) { return TriArea(a, b, c) <= 0.0f; }
+
+	// Vertex access wrapping around either end
+	const vec2& At(const std::vector<vec2>& polygon, int32_t i)
+	{
+		int32_t n = (int32_t)polygon.size();
+		return polygon[((i % n) + n) % n];
+	}
+
+	bool IsReflex(const std::vector<vec2>& polygon, int32_t i)
+	{
+		return Right(At(polygon, i - 1), At(polygon, i), At(polygon, i + 1));
+	}
+
+	// Where the infinite lines through a1 -> a2 & b1 -> b2 meet
+	vec2 LineIntersection(const vec2& a1, const vec2& a2, const vec2& b1, const vec2& b2)
+	{
+		vec2 da = a2 - a1;
+		vec2 db = b2 - b1;
+		float denom = cross(da, db);
+		if (fabs(denom) < epsilon<float>())
+			return a1;
+		return a1 + da * (cross(b1 - a1, db) / denom);
+	}
+
+	// Segments cross at a point inside both, touching ends don't count
+	bool SegmentsCross(const vec2& p1, const vec2& p2, const vec2& q1, const vec2& q2)
+	{
+		float d1 = TriArea(q1, q2, p1);
+		float d2 = TriArea(q1, q2, p2);
+		float d3 = TriArea(p1, p2, q1);
+		float d4 = TriArea(p1, p2, q2);
+		return ((d1 > 0.0f && d2 < 0.0f) || (d1 < 0.0f && d2 > 0.0f)) && ((d3 > 0.0f && d4 < 0.0f) || (d3 < 0.0f && d4 > 0.0f));
+	}
+
+	// A diagonal from i to j lies inside the polygon
+	bool CanSee(const std::vector<vec2>& polygon, int32_t i, int32_t j)
+	{
+		int32_t n = (int32_t)polygon.size();
+		const vec2& a = At(polygon, i);
+		const vec2& b = At(polygon, j);
+
+		// Must leave each end into the interior
+		if (IsReflex(polygon, i))
+		{
+			if (LeftOn(a, At(polygon, i - 1), b) && RightOn(a, At(polygon, i + 1), b))
+				return false;
+		}
+		else if (RightOn(a, At(polygon, i + 1), b) || LeftOn(a, At(polygon, i - 1), b))
+			return false;
+
+		if (IsReflex(polygon, j))
+		{
+			if (LeftOn(b, At(polygon, j - 1), a) && RightOn(b, At(polygon, j + 1), a))
+				return false;
+		}
+		else if (RightOn(b, At(polygon, j + 1), a) || LeftOn(b, At(polygon, j - 1), a))
+			return false;
+
+		// & cross no edge on the way
+		for (int32_t k = 0; k < n; ++k)
+		{
+			int32_t k1 = (k + 1) % n;
+			if (k == i || k1 == i || k == j || k1 == j)
+				continue;
+			if (SegmentsCross(a, b, polygon[k], polygon[k1]))
+				return false;
+		}
+		return true;
+	}
+
+	// Vertices from i to j inclusive, wrapping past the end
+	void Copy(const std::vector<vec2>& polygon, int32_t i, int32_t j, std::vector<vec2>& out)
+	{
+		int32_t n = (int32_t)polygon.size();
+		if (j < i)
+			j += n;
+		for (int32_t k = i; k <= j; ++k)
+			out.push_back(At(polygon, k));
+	}
+
+	// Appends a convex piece, dropping collinear corners & splitting it while over budget
+	void EmitConvex(std::vector<vec2>& polygon, uint32_t maxVertices, ConvexPieces& pieces)
+	{
+		for (size_t i = 0; i < polygon.size() && polygon.size() > 2;)
+		{
+			if (fabs(TriArea(At(polygon, (int32_t)i - 1), polygon[i], At(polygon, (int32_t)i + 1))) < epsilon<float>())
+				polygon.erase(polygon.begin() + i);
+			else
+				++i;
+		}
+
+		// Slivers can't make a valid body
+		if (polygon.size() < 3 || decomp::SignedArea(polygon.data(), (uint32_t)polygon.size()) < 1.0f)
+			return;
+
+		if (polygon.size() > maxVertices)
+		{
+			// Any diagonal splits a convex polygon into two convex halves
+			int32_t half = (int32_t)polygon.size() / 2;
+			std::vector<vec2> lower, upper;
+			Copy(polygon, 0, half, lower);
+			Copy(polygon, half, 0, upper);
+			EmitConvex(lower, maxVertices, pieces);
+			EmitConvex(upper, maxVertices, pieces);
+			return;
+		}
+
+		pieces.vertices.insert(pieces.vertices.end(), polygon.begin(), polygon.end());
+		pieces.starts.push_back((uint32_t)pieces.vertices.size());
+	}
+
+	void Decompose(std::vector<vec2>& polygon, uint32_t maxVertices, ConvexPieces& pieces)
+	{
+		int32_t n = (int32_t)polygon.size();
+		if (n < 3)
+			return;
+
+		for (int32_t i = 0; i < n; ++i)
+		{
+			if (!IsReflex(polygon, i))
+				continue;
+
+			// Extend both edges at the reflex vertex, finding the closest edges they hit
+			float lowerDist = FLT_MAX, upperDist = FLT_MAX;
+			const vec2& v = polygon[i];
+			vec2 lowerInt = v, upperInt = v;
+			int32_t lowerIndex = 0, upperIndex = 0;
+			for (int32_t j = 0; j < n; ++j)
+			{
+				if (Left(At(polygon, i - 1), v, At(polygon, j)) && RightOn(At(polygon, i - 1), v, At(polygon, j - 1)))
+				{
+					vec2 p = LineIntersection(At(polygon, i - 1), v, At(polygon, j), At(polygon, j - 1));
+					if (Right(At(polygon, i + 1), v, p))
+					{
+						float d = distance2(v, p);
+						if (d < lowerDist)
+						{
+							lowerDist = d;
+							lowerInt = p;
+							lowerIndex = j;
+						}
+					}
+				}
+				if (Left(At(polygon, i + 1), v, At(polygon, j + 1)) && RightOn(At(polygon, i + 1), v, At(polygon, j)))
+				{
+					vec2 p = LineIntersection(At(polygon, i + 1), v, At(polygon, j), At(polygon, j + 1));
+					if (Left(At(polygon, i - 1), v, p))
+					{
+						float d = distance2(v, p);
+						if (d < upperDist)
+						{
+							upperDist = d;
+							upperInt = p;
+							upperIndex = j;
+						}
+					}
+				}
+			}
+
+			// Both rays hit something in any simple polygon, degenerate input settles for the hull
+			if (lowerDist == FLT_MAX || upperDist == FLT_MAX)
+				break;
+
+			std::vector<vec2> lower, upper;
+			if (lowerIndex == (upperIndex + 1) % n)
+			{
+				// No vertex between the hits, split at a new point halfway along them
+				vec2 steiner = (lowerInt + upperInt) * 0.5f;
+				Copy(polygon, i, upperIndex, lower);
+				lower.push_back(steiner);
+				upper.push_back(steiner);
+				Copy(polygon, lowerIndex, i, upper);
+			}
+			else
+			{
+				// Favour reflex vertices the diagonal also resolves, then closer ones
+				float bestScore = 0.0f;
+				int32_t best = lowerIndex;
+				if (upperIndex < lowerIndex)
+					upperIndex += n;
+				for (int32_t j = lowerIndex; j <= upperIndex; ++j)
+				{
+					if (!CanSee(polygon, i, j))
+						continue;
+
+					const vec2& w = At(polygon, j);
+					float score = 1.0f / (distance2(v, w) + 1.0f);
+					if (IsReflex(polygon, j))
+						score += RightOn(At(polygon, j - 1), w, v) && LeftOn(At(polygon, j + 1), w, v) ? 3.0f : 2.0f;
+					else
+						score += 1.0f;
+
+					if (score > bestScore)
+					{
+						bestScore = score;
+						best = j % n;
+					}
+				}
+				Copy(polygon, i, best, lower);
+				Copy(polygon, best, i, upper);
+			}
+
+			// Degenerate input can fail to make progress, settle for the hull then
+			if (lower.size() >= (size_t)n || upper.size() >= (size_t)n)
+				break;
+
+			Decompose(lower, maxVertices, pieces);
+			Decompose(upper, maxVertices, pieces);
+			return;
+		}
+
+		EmitConvex(polygon, maxVertices, pieces);
+	}
+
+	// Widest spread of the run's points across the line joining its ends
+	float RunSpread(const vec2* points, uint32_t start, uint32_t end)
+	{
+		vec2 axis = points[end] - points[start];
+		float len = length(axis);
+		if (len < epsilon<float>())
+			return FLT_MAX;
+		axis /= len;
+
+		float dMin = 0.0f, dMax = 0.0f;
+		for (uint32_t i = start + 1; i < end; ++i)
+		{
+			float d = cross(axis, points[i] - points[start]);
+			dMin = min(dMin, d);
+			dMax = max(dMax, d);
+		}
+		return dMax - dMin;
+	}
+
+	// Box aligned to the run's ends, covering every point padded by half the thickness
+	void AddRunBox(const vec2* points, uint32_t start, uint32_t end, float halfThickness, ConvexPieces& pieces)
+	{
+		const vec2& origin = points[start];
+		vec2 axis = points[end] - origin;
+		float len = length(axis);
+		axis = len > epsilon<float>() ? axis / len : vec2(1, 0);
+		vec2 perp(-axis.y, axis.x);
+
+		float tMin = 0.0f, tMax = 0.0f, dMin = 0.0f, dMax = 0.0f;
+		for (uint32_t i = start + 1; i <= end; ++i)
+		{
+			vec2 offset = points[i] - origin;
+			float t = dot(axis, offset);
+			float d = dot(perp, offset);
+			tMin = min(tMin, t);
+			tMax = max(tMax, t);
+			dMin = min(dMin, d);
+			dMax = max(dMax, d);
+		}
+		tMin -= halfThickness;
+		tMax += halfThickness;
+		dMin -= halfThickness;
+		dMax += halfThickness;
+
+		pieces.vertices.push_back(origin + axis * tMin + perp * dMin);
+		pieces.vertices.push_back(origin + axis * tMax + perp * dMin);
+		pieces.vertices.push_back(origin + axis * tMax + perp * dMax);
+		pieces.vertices.push_back(origin + axis * tMin + perp * dMax);
+		pieces.starts.push_back((uint32_t)pieces.vertices.size());
+	}
+}
+
+void decomp::SimplifyPolyline(const vec2* points, uint32_t count, float tolerance, std::vector<vec2>& out)
+{
+	out.clear();
+	if (count < 3)
+	{
+		out.assign(points, points + count);
+		return;
+	}
+
+	// Reused between calls
+	static thread_local std::vector<uint8_t> s_keep;
+	static thread_local std::vector<std::pair<uint32_t, uint32_t>> s_stack;
+	s_keep.assign(count, 0);
+	s_keep[0] = s_keep[count - 1] = 1;
+
+	// Keep the furthest point from each span's line if it's beyond tolerance, then split the span there
+	s_stack.clear();
+	s_stack.push_back(std::make_pair(0U, count - 1));
+	float tolerance2 = hamh::sqr(tolerance);
+	while (!s_stack.empty())
+	{
+		uint32_t first = s_stack.back().first;
+		uint32_t last = s_stack.back().second;
+		s_stack.pop_back();
+
+		vec2 line = points[last] - points[first];
+		float len2 = length2(line);
+
+		float furthest = 0.0f;
+		uint32_t index = first;
+		for (uint32_t i = first + 1; i < last; ++i)
+		{
+			// Distance to the line, or to the point when the span's ends meet
+			float d2 = len2 > epsilon<float>() ? hamh::sqr(cross(line, points[i] - points[first])) / len2 : distance2(points[i], points[first]);
+			if (d2 > furthest)
+			{
+				furthest = d2;
+				index = i;
+			}
+		}
+
+		if (furthest > tolerance2)
+		{
+			s_keep[index] = 1;
+			s_stack.push_back(std::make_pair(first, index));
+			s_stack.push_back(std::make_pair(index, last));
+		}
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+		if (s_keep[i])
+			out.push_back(points[i]);
+}
+
+float decomp::SignedArea(const vec2* polygon, uint32_t count)
+{
+	float area = 0.0f;
+	for (uint32_t i = 0; i < count; ++i)
+		area += cross(polygon[i], polygon[i + 1 < count ? i + 1 : 0]);
+	return area * 0.5f;
+}
+
+vec2 decomp::Centroid(const vec2* polygon, uint32_t count)
+{
+	vec2 centroid(0, 0);
+	float area = 0.0f;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const vec2& a = polygon[i];
+		const vec2& b = polygon[i + 1 < count ? i + 1 : 0];
+		float c = cross(a, b);
+		area += c;
+		centroid += (a + b) * c;
+	}
+	return fabs(area) > epsilon<float>() ? centroid / (3.0f * area) : polygon[0];
+}
+
+bool decomp::IsSimple(const vec2* polygon, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const vec2& a1 = polygon[i];
+		const vec2& a2 = polygon[i + 1 < count ? i + 1 : 0];
+		// Neighbouring edges share a vertex, so start two along & skip the edge wrapping back to i
+		for (uint32_t j = i + 2; j < count; ++j)
+		{
+			if (i == 0 && j + 1 == count)
+				continue;
+			if (SegmentsCross(a1, a2, polygon[j], polygon[j + 1 < count ? j + 1 : 0]))
+				return false;
+		}
+	}
+	return true;
+}
+
+void decomp::DecomposePolygon(const vec2* polygon, uint32_t count, uint32_t maxVertices, ConvexPieces& pieces)
+{
+	assert(maxVertices >= 3);
+	if (pieces.starts.empty())
+		pieces.starts.push_back(0);
+
+	std::vector<vec2> working(polygon, polygon + count);
+	Decompose(working, maxVertices, pieces);
+}
+
+void decomp::DecomposeStroke(const vec2* points, uint32_t count, float thickness, float tolerance, ConvexPieces& pieces)
+{
+	if (pieces.starts.empty())
+		pieces.starts.push_back(0);
+	if (count == 0)
+		return;
+
+	float halfThickness = thickness * 0.5f;
+	uint32_t start = 0;
+	while (true)
+	{
+		// Grow the run for as long as it stays straight enough
+		uint32_t end = start + 1 < count ? start + 1 : start;
+		while (end + 1 < count && RunSpread(points, start, end + 1) <= tolerance)
+			++end;
+
+		AddRunBox(points, start, end, halfThickness, pieces);
+		if (end + 1 >= count)
+			break;
+		// Runs share their end points, so neighbouring boxes overlap at the joins
+		start = end;
+	}
+}
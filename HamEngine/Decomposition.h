@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Rigidbody.h"
+
+// Convex polygons packed end to end, each counter clockwise
+// Reused between calls, so it only allocates while growing
+struct ConvexPieces
+{
+	std::vector<vec2> vertices;
+	std::vector<uint32_t> starts;	// First vertex of each piece, plus one past the last
+
+	void Clear() { vertices.clear(); starts.assign(1, 0); }
+
+	uint32_t GetCount() const { return starts.empty() ? 0 : (uint32_t)starts.size() - 1; }
+	const vec2* GetPiece(uint32_t index) const { return vertices.data() + starts[index]; }
+	uint32_t GetPieceSize(uint32_t index) const { return starts[index + 1] - starts[index]; }
+};
+
+// Splits freeform shapes into convex pieces that bodies can be built from
+namespace decomp
+{
+	// Ramer-Douglas-Peucker, drops points closer than tolerance to the line through the points kept either side
+	void SimplifyPolyline(const vec2* points, uint32_t count, float tolerance, std::vector<vec2>& out);
+
+	// Positive for counter clockwise polygons
+	float SignedArea(const vec2* polygon, uint32_t count);
+	// Centre of area, matching where a polygon body built from the points would be centred
+	vec2 Centroid(const vec2* polygon, uint32_t count);
+	// True when no two non-adjacent edges cross
+	bool IsSimple(const vec2* polygon, uint32_t count);
+
+	// Bayazit's decomposition of a simple counter clockwise polygon, appending pieces of at most maxVertices corners
+	// Each reflex vertex is resolved by a diagonal to the best visible vertex, or a new point when none can be seen
+	void DecomposePolygon(const vec2* polygon, uint32_t count, uint32_t maxVertices, ConvexPieces& pieces);
+
+	// Covers a polyline of the given thickness with boxes, appending one per run of points
+	// Runs grow while their points stray no further than tolerance across the line joining the run's ends
+	void DecomposeStroke(const vec2* points, uint32_t count, float thickness, float tolerance, ConvexPieces& pieces);
+}
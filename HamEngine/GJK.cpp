@@ -0,0 +1,330 @@
+#include "GJK.h"
+
+namespace
+{
+	const uint32_t GJK_MAXITERATIONS = 20;
+	const uint32_t EPA_MAXITERATIONS = 20;
+	const uint32_t EPA_MAXVERTICES = EPA_MAXITERATIONS + 3;
+	const float EPA_TOLERANCE = 0.01f;
+
+	// Point on the Minkowski difference B - A, with the support points that made it
+	struct SimplexVertex
+	{
+		vec2 wA;
+		vec2 wB;
+		vec2 w;			// wB - wA
+		float a;		// Barycentric coordinate of closest point
+	};
+
+	SimplexVertex GetVertex(Rigidbody* a, Rigidbody* b, const vec2& dir)
+	{
+		SimplexVertex v;
+		v.wA = a->GetWorldSupport(-dir);
+		v.wB = b->GetWorldSupport(dir);
+		v.w = v.wB - v.wA;
+		v.a = 1.0f;
+		return v;
+	}
+
+	struct Simplex
+	{
+		SimplexVertex v[3];
+		uint32_t count;
+
+		// Reduce to the feature closest to the origin, setting barycentric coordinates
+		void Solve2()
+		{
+			vec2 e12 = v[1].w - v[0].w;
+
+			// w1 region
+			float d12_2 = -dot(v[0].w, e12);
+			if (d12_2 <= 0.0f)
+			{
+				v[0].a = 1.0f;
+				count = 1;
+				return;
+			}
+
+			// w2 region
+			float d12_1 = dot(v[1].w, e12);
+			if (d12_1 <= 0.0f)
+			{
+				v[1].a = 1.0f;
+				v[0] = v[1];
+				count = 1;
+				return;
+			}
+
+			// Must be in e12 region
+			float inv = 1.0f / (d12_1 + d12_2);
+			v[0].a = d12_1 * inv;
+			v[1].a = d12_2 * inv;
+		}
+
+		void Solve3()
+		{
+			vec2 w1 = v[0].w;
+			vec2 w2 = v[1].w;
+			vec2 w3 = v[2].w;
+
+			// Edge regions
+			vec2 e12 = w2 - w1;
+			float d12_1 = dot(w2, e12);
+			float d12_2 = -dot(w1, e12);
+
+			vec2 e13 = w3 - w1;
+			float d13_1 = dot(w3, e13);
+			float d13_2 = -dot(w1, e13);
+
+			vec2 e23 = w3 - w2;
+			float d23_1 = dot(w3, e23);
+			float d23_2 = -dot(w2, e23);
+
+			// Triangle region
+			float n123 = cross(e12, e13);
+			float d123_1 = n123 * cross(w2, w3);
+			float d123_2 = n123 * cross(w3, w1);
+			float d123_3 = n123 * cross(w1, w2);
+
+			// w1 region
+			if (d12_2 <= 0.0f && d13_2 <= 0.0f)
+			{
+				v[0].a = 1.0f;
+				count = 1;
+				return;
+			}
+
+			// e12
+			if (d12_1 > 0.0f && d12_2 > 0.0f && d123_3 <= 0.0f)
+			{
+				float inv = 1.0f / (d12_1 + d12_2);
+				v[0].a = d12_1 * inv;
+				v[1].a = d12_2 * inv;
+				count = 2;
+				return;
+			}
+
+			// e13
+			if (d13_1 > 0.0f && d13_2 > 0.0f && d123_2 <= 0.0f)
+			{
+				float inv = 1.0f / (d13_1 + d13_2);
+				v[0].a = d13_1 * inv;
+				v[2].a = d13_2 * inv;
+				v[1] = v[2];
+				count = 2;
+				return;
+			}
+
+			// w2 region
+			if (d12_1 <= 0.0f && d23_2 <= 0.0f)
+			{
+				v[1].a = 1.0f;
+				v[0] = v[1];
+				count = 1;
+				return;
+			}
+
+			// w3 region
+			if (d13_1 <= 0.0f && d23_1 <= 0.0f)
+			{
+				v[2].a = 1.0f;
+				v[0] = v[2];
+				count = 1;
+				return;
+			}
+
+			// e23
+			if (d23_1 > 0.0f && d23_2 > 0.0f && d123_1 <= 0.0f)
+			{
+				float inv = 1.0f / (d23_1 + d23_2);
+				v[1].a = d23_1 * inv;
+				v[2].a = d23_2 * inv;
+				v[0] = v[2];
+				count = 2;
+				return;
+			}
+
+			// Must be in triangle123, origin is enclosed
+			float inv = 1.0f / (d123_1 + d123_2 + d123_3);
+			v[0].a = d123_1 * inv;
+			v[1].a = d123_2 * inv;
+			v[2].a = d123_3 * inv;
+			count = 3;
+		}
+
+		vec2 GetSearchDirection()
+		{
+			if (count == 1)
+				return -v[0].w;
+
+			// Perpendicular of the edge facing the origin
+			vec2 e12 = v[1].w - v[0].w;
+			if (cross(e12, -v[0].w) > 0.0f)
+				return vec2(-e12.y, e12.x);
+			else
+				return vec2(e12.y, -e12.x);
+		}
+
+		void GetWitnessPoints(vec2& pA, vec2& pB)
+		{
+			pA = vec2(0, 0);
+			pB = vec2(0, 0);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				pA += v[i].a * v[i].wA;
+				pB += v[i].a * v[i].wB;
+			}
+		}
+	};
+
+	// Expands the enclosing simplex until the closest edge of the Minkowski difference is found
+	void EPA(Rigidbody* a, Rigidbody* b, Simplex& simplex, GJKResult& result)
+	{
+		SimplexVertex polytope[EPA_MAXVERTICES];
+		uint32_t count = 3;
+		for (uint32_t i = 0; i < 3; ++i)
+			polytope[i] = simplex.v[i];
+
+		// Wind counter clockwise, so edge normals face outwards
+		if (cross(polytope[1].w - polytope[0].w, polytope[2].w - polytope[0].w) < 0.0f)
+			std::swap(polytope[1], polytope[2]);
+
+		uint32_t closestEdge = 0;
+		vec2 closestNormal = vec2();
+		float closestDistance = FLT_MAX;
+
+		for (uint32_t iteration = 0; iteration < EPA_MAXITERATIONS; ++iteration)
+		{
+			closestDistance = FLT_MAX;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				uint32_t j = i + 1 < count ? i + 1 : 0;
+				vec2 edge = polytope[j].w - polytope[i].w;
+				if (length2(edge) < hamh::sqr(epsilon<float>()))
+					continue;
+
+				vec2 n = normalize(vec2(edge.y, -edge.x));
+				float d = dot(n, polytope[i].w);
+				if (d < closestDistance)
+				{
+					closestDistance = d;
+					closestNormal = n;
+					closestEdge = i;
+				}
+			}
+
+			// Stop once the boundary can't be pushed out any further
+			SimplexVertex support = GetVertex(a, b, closestNormal);
+			if (dot(support.w, closestNormal) - closestDistance < EPA_TOLERANCE || count == EPA_MAXVERTICES)
+				break;
+
+			// Insert new vertex between the closest edge's vertices
+			for (uint32_t i = count; i > closestEdge + 1; --i)
+				polytope[i] = polytope[i - 1];
+			polytope[closestEdge + 1] = support;
+			++count;
+		}
+
+		// Witness points from the origin's projection onto the closest edge
+		SimplexVertex& v1 = polytope[closestEdge];
+		SimplexVertex& v2 = polytope[closestEdge + 1 < count ? closestEdge + 1 : 0];
+		vec2 edge = v2.w - v1.w;
+		float t = clamp(-dot(v1.w, edge) / max(length2(edge), epsilon<float>()), 0.0f, 1.0f);
+
+		result.overlapping = true;
+		result.distance = closestDistance;
+		// Boundary normal points out of B - A, separating B means moving against it
+		result.normal = -closestNormal;
+		result.pointA = v1.wA + t * (v2.wA - v1.wA);
+		result.pointB = v1.wB + t * (v2.wB - v1.wB);
+	}
+}
+
+GJKResult gjk::Query(Rigidbody* a, Rigidbody* b)
+{
+	GJKResult result;
+
+	Simplex simplex;
+	simplex.v[0] = GetVertex(a, b, b->GetPosition() - a->GetPosition());
+	simplex.count = 1;
+
+	// Previous vertices, for catching duplicates
+	vec2 saveA[3], saveB[3];
+
+	for (uint32_t iteration = 0;; ++iteration)
+	{
+		uint32_t saveCount = simplex.count;
+		for (uint32_t i = 0; i < saveCount; ++i)
+		{
+			saveA[i] = simplex.v[i].wA;
+			saveB[i] = simplex.v[i].wB;
+		}
+
+		if (simplex.count == 2)
+			simplex.Solve2();
+		else if (simplex.count == 3)
+			simplex.Solve3();
+
+		// Origin is enclosed by the simplex
+		if (simplex.count == 3 || iteration == GJK_MAXITERATIONS)
+			break;
+
+		// Origin lies on the simplex, the cores are touching
+		vec2 dir = simplex.GetSearchDirection();
+		if (length2(dir) < hamh::sqr(epsilon<float>()))
+			break;
+
+		SimplexVertex vertex = GetVertex(a, b, dir);
+
+		// Repeated support points mean no further progress can be made
+		bool duplicate = false;
+		for (uint32_t i = 0; i < saveCount; ++i)
+		{
+			if (vertex.wA == saveA[i] && vertex.wB == saveB[i])
+			{
+				duplicate = true;
+				break;
+			}
+		}
+		if (duplicate)
+			break;
+
+		simplex.v[simplex.count++] = vertex;
+	}
+
+	simplex.GetWitnessPoints(result.pointA, result.pointB);
+
+	// Origin on a segment simplex, grow it into a triangle so EPA can find the depth
+	if (simplex.count == 2 && distance2(result.pointA, result.pointB) < hamh::sqr(epsilon<float>()))
+	{
+		vec2 edge = simplex.v[1].w - simplex.v[0].w;
+		vec2 perp = vec2(-edge.y, edge.x);
+		for (uint32_t i = 0; i < 2 && simplex.count == 2; ++i, perp = -perp)
+		{
+			SimplexVertex vertex = GetVertex(a, b, perp);
+			if (dot(vertex.w - simplex.v[0].w, perp) > epsilon<float>())
+				simplex.v[simplex.count++] = vertex;
+		}
+	}
+
+	if (simplex.count == 3)
+	{
+		EPA(a, b, simplex, result);
+		return result;
+	}
+
+	vec2 delta = result.pointB - result.pointA;
+	result.distance = length(delta);
+
+	if (result.distance > epsilon<float>())
+		result.normal = delta / result.distance;
+	else
+	{
+		// Touching or degenerate overlap (e.g. parallel segments), no usable depth
+		vec2 centres = b->GetPosition() - a->GetPosition();
+		result.overlapping = true;
+		result.distance = 0.f;
+		result.normal = length2(centres) > hamh::sqr(epsilon<float>()) ? normalize(centres) : vec2(0, 1);
+	}
+	return result;
+}
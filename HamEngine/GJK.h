@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Rigidbody.h"
+
+// Result of a GJK/EPA query between two convex shapes
+struct GJKResult
+{
+	bool overlapping = false;	// Cores intersect, distance is penetration depth
+	float distance = 0.f;		// Distance between cores, or penetration depth when overlapping
+	vec2 normal = vec2();		// A -> B
+	vec2 pointA = vec2();		// Witness point on A's core
+	vec2 pointB = vec2();		// Witness point on B's core
+};
+
+// Generic convex collision built purely on shape support functions
+// Rounded shapes are queried by their core, radii are applied by the caller
+namespace gjk
+{
+	// Closest points between cores, falling back to EPA for penetration when they overlap
+	GJKResult Query(Rigidbody* a, Rigidbody* b);
+}
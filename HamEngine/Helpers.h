@@ -5,37 +5,136 @@
 #include <glm/gtc/constants.hpp>
 #include <glm/ext.hpp>
 
+// SSE2 is baseline on every target the engine builds for, but keep a scalar fallback
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAMH_SSE
+#include <emmintrin.h>
+#endif
+
+// Bit-identical simulation across machines & builds, for lockstep replays
+// Swaps libm trig for a fixed polynomial & stops the compiler fusing multiply-adds
+// #define HAMH_DETERMINISTIC
+
+#ifdef HAMH_DETERMINISTIC
+#ifndef HAMH_SSE
+#error HAMH_DETERMINISTIC requires SSE2 floating point, x87 rounds intermediates differently
+#endif
+#if defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+// GCC ignores the STDC pragma, same as -ffp-contract=off
+#pragma GCC optimize("fp-contract=off")
+#else
+#error HAMH_DETERMINISTIC has no way to stop this compiler contracting floating point
+#endif
+#endif
+
 namespace hamh
 {
-	// Return float in the range of 0..1
-	inline float fRand()
+	inline float Degrees2Radians(float degrees)
 	{
-		return ((float)rand() / RAND_MAX);
+		return degrees * glm::pi<float>() / 180.0f;
 	}
 
-	inline int RandRange(int lower, int higher)
+	// Polynomial sine & cosine, within 1e-7 of the true values for |radians| < 8192
+	// Only + & * after reduction, so every IEEE machine agrees & SinCosBatch can match it exactly
+	inline void FastSinCos(float radians, float& s, float& c)
 	{
-		int range = higher - lower;
-		return (rand() % range + lower);
+		// Reduce to [-pi/4, pi/4] around the nearest quarter turn, pi/2 split in 3 for precision
+		float q = floor(radians * 0.636619772f + 0.5f);
+		float r = radians - q * 1.5703125f;
+		r -= q * 4.83751297e-4f;
+		r -= q * 7.54978995e-8f;
+		float z = r * r;
+
+		// Cephes minimax polynomials
+		float sr = r + r * z * (-1.66666546e-1f + z * (8.33216087e-3f + z * -1.95152959e-4f));
+		float cr = 1.0f - 0.5f * z + z * z * (4.16666457e-2f + z * (-1.38873163e-3f + z * 2.44331571e-5f));
+
+		switch ((int)q & 3)
+		{
+		case 0: s = sr; c = cr; break;
+		case 1: s = cr; c = -sr; break;
+		case 2: s = -sr; c = -cr; break;
+		default: s = -cr; c = sr; break;
+		}
 	}
 
-	inline float Degrees2Radians(float degrees)
+	// FastSinCos of count angles, four lanes at a time where SSE is available
+	inline void SinCosBatch(const float* radians, float* s, float* c, uint32_t count)
 	{
-		return degrees * glm::pi<float>() / 180.0f;
+		uint32_t i = 0;
+#ifdef HAMH_SSE
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(radians + i);
+
+			// Floor via truncation, stepping down where that rounded up
+			__m128 t = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(0.636619772f)), half);
+			__m128 q = _mm_cvtepi32_ps(_mm_cvttps_epi32(t));
+			q = _mm_sub_ps(q, _mm_and_ps(_mm_cmpgt_ps(q, t), one));
+			__m128i quadrant = _mm_cvttps_epi32(q);
+
+			__m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(1.5703125f)));
+			r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(4.83751297e-4f)));
+			r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(7.54978995e-8f)));
+			__m128 z = _mm_mul_ps(r, r);
+
+			__m128 sp = _mm_add_ps(_mm_set1_ps(8.33216087e-3f), _mm_mul_ps(z, _mm_set1_ps(-1.95152959e-4f)));
+			sp = _mm_add_ps(_mm_set1_ps(-1.66666546e-1f), _mm_mul_ps(z, sp));
+			__m128 sr = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), sp));
+
+			__m128 cp = _mm_add_ps(_mm_set1_ps(-1.38873163e-3f), _mm_mul_ps(z, _mm_set1_ps(2.44331571e-5f)));
+			cp = _mm_add_ps(_mm_set1_ps(4.16666457e-2f), _mm_mul_ps(z, cp));
+			__m128 cr = _mm_add_ps(_mm_sub_ps(one, _mm_mul_ps(half, z)), _mm_mul_ps(_mm_mul_ps(z, z), cp));
+
+			// Odd quadrants swap sine & cosine, then each picks up its sign as a set top bit
+			__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+			__m128 sv = _mm_or_ps(_mm_and_ps(swap, cr), _mm_andnot_ps(swap, sr));
+			__m128 cv = _mm_or_ps(_mm_and_ps(swap, sr), _mm_andnot_ps(swap, cr));
+			__m128 sNeg = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+			__m128 cNeg = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+			_mm_storeu_ps(s + i, _mm_xor_ps(sv, sNeg));
+			_mm_storeu_ps(c + i, _mm_xor_ps(cv, cNeg));
+		}
+#endif
+		for (; i < count; ++i)
+			FastSinCos(radians[i], s[i], c[i]);
 	}
 
-	// Set rotation of a rotation matrix to specified radians
-	inline void SetRotation(glm::mat2& matrix, float radians)
+	// Sine & cosine of the same angle
+	inline void SinCos(float radians, float& s, float& c)
 	{
-		float c = cos(radians);
-		float s = sin(radians);
+#ifdef HAMH_DETERMINISTIC
+		FastSinCos(radians, s, c);
+#else
+		s = sin(radians);
+		c = cos(radians);
+#endif
+	}
 
+	// Set rotation of a rotation matrix from its angle's sine & cosine
+	inline void SetRotation(glm::mat2& matrix, float s, float c)
+	{
 		matrix[0][0] = c;
-		matrix[0][1] = -s;
-		matrix[1][0] = s;
+		matrix[0][1] = s;
+		matrix[1][0] = -s;
 		matrix[1][1] = c;
 	}
 
+	// Set rotation of a rotation matrix to specified radians
+	inline void SetRotation(glm::mat2& matrix, float radians)
+	{
+		float c, s;
+		SinCos(radians, s, c);
+		SetRotation(matrix, s, c);
+	}
+
 	inline glm::vec2 cross(float a, const glm::vec2& v)
 	{
 		return glm::vec2(-a * v.y, a * v.x);
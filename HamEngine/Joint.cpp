@@ -0,0 +1,147 @@
+#include "Joint.h"
+
+void JointRows::Allocate(aie::LinearArena& arena, uint32_t rows, uint32_t joints, uint32_t batches)
+{
+	bodyA = arena.allocateArray<Rigidbody*>(rows);
+	bodyB = arena.allocateArray<Rigidbody*>(rows);
+	normalX = arena.allocateArray<float>(rows);
+	normalY = arena.allocateArray<float>(rows);
+	angularA = arena.allocateArray<float>(rows);
+	angularB = arena.allocateArray<float>(rows);
+	effectiveMass = arena.allocateArray<float>(rows);
+	bias = arena.allocateArray<float>(rows);
+	rowCount = 0;
+
+	jointRowStart = arena.allocateArray<uint32_t>(joints + 1);
+	batchStart = arena.allocateArray<uint32_t>(batches + 1);
+	batchCount = batches;
+}
+
+void JointRows::Add(Rigidbody* a, Rigidbody* b, const vec2& n, float angA, float angB, float error, float timeStep)
+{
+	MassData massA = a->GetMassData();
+	MassData massB = b->GetMassData();
+
+	float k = (massA.iMass + massB.iMass) * length2(n) + massA.iInertia * hamh::sqr(angA) + massB.iInertia * hamh::sqr(angB);
+
+	bodyA[rowCount] = a;
+	bodyB[rowCount] = b;
+	normalX[rowCount] = n.x;
+	normalY[rowCount] = n.y;
+	angularA[rowCount] = angA;
+	angularB[rowCount] = angB;
+	effectiveMass[rowCount] = k > 0.0f ? 1.0f / k : 0.0f;
+	bias[rowCount] = JOINT_BAUMGARTE / timeStep * error;
+	++rowCount;
+}
+
+void JointRows::SolveJoint(uint32_t joint)
+{
+	for (uint32_t row = jointRowStart[joint]; row < jointRowStart[joint + 1]; ++row)
+	{
+		Rigidbody* a = bodyA[row];
+		Rigidbody* b = bodyB[row];
+		vec2 n(normalX[row], normalY[row]);
+
+		float cdot = dot(n, b->GetVelocity() - a->GetVelocity()) + angularB[row] * b->GetAngularVelocity() - angularA[row] * a->GetAngularVelocity();
+		float lambda = -effectiveMass[row] * (cdot + bias[row]);
+
+		a->ApplyImpulse(-n * lambda, -angularA[row] * lambda);
+		b->ApplyImpulse(n * lambda, angularB[row] * lambda);
+	}
+}
+
+Joint::Joint(JointType a_type, Rigidbody* a_a, Rigidbody* a_b, vec2 a_anchorA, vec2 a_anchorB, vec2 a_axis)
+{
+	m_type = a_type;
+	m_a = a_a;
+	m_b = a_b;
+
+	// Pinning joints share one anchor
+	if (m_type != JointType::JT_DISTANCE)
+		a_anchorB = a_anchorA;
+
+	mat2 rotA, rotB;
+	hamh::SetRotation(rotA, m_a->GetOrient());
+	hamh::SetRotation(rotB, m_b->GetOrient());
+
+	m_localAnchorA = transpose(rotA) * (a_anchorA - m_a->GetPosition());
+	m_localAnchorB = transpose(rotB) * (a_anchorB - m_b->GetPosition());
+	m_localAxis = transpose(rotA) * normalize(a_axis);
+
+	m_length = distance(a_anchorA, a_anchorB);
+	m_referenceAngle = m_b->GetOrient() - m_a->GetOrient();
+}
+
+uint32_t Joint::GetRowCount()
+{
+	switch (m_type)
+	{
+	case JointType::JT_DISTANCE:
+		return 1;
+	case JointType::JT_WELD:
+		return 3;
+	default:
+		return 2;
+	}
+}
+
+void Joint::BuildRows(JointRows& rows, float timeStep)
+{
+	mat2 rotA, rotB;
+	hamh::SetRotation(rotA, m_a->GetOrient());
+	hamh::SetRotation(rotB, m_b->GetOrient());
+
+	// Anchor arms & separation in world space
+	vec2 rA = rotA * m_localAnchorA;
+	vec2 rB = rotB * m_localAnchorB;
+	vec2 d = m_b->GetPosition() + rB - m_a->GetPosition() - rA;
+
+	float angleError = m_b->GetOrient() - m_a->GetOrient() - m_referenceAngle;
+
+	switch (m_type)
+	{
+	case JointType::JT_DISTANCE:
+	{
+		float len = length(d);
+		vec2 n = len > epsilon<float>() ? d / len : vec2(1, 0);
+		rows.Add(m_a, m_b, n, cross(rA, n), cross(rB, n), len - m_length, timeStep);
+		break;
+	}
+	case JointType::JT_REVOLUTE:
+	case JointType::JT_WELD:
+	{
+		// Point constraint as one row per axis
+		vec2 x(1, 0), y(0, 1);
+		rows.Add(m_a, m_b, x, cross(rA, x), cross(rB, x), d.x, timeStep);
+		rows.Add(m_a, m_b, y, cross(rA, y), cross(rB, y), d.y, timeStep);
+		if (m_type == JointType::JT_WELD)
+			rows.Add(m_a, m_b, vec2(0, 0), 1.0f, 1.0f, angleError, timeStep);
+		break;
+	}
+	case JointType::JT_PRISMATIC:
+	{
+		// Lock movement perpendicular to the axis, which rotates with A
+		vec2 axis = rotA * m_localAxis;
+		vec2 perp(-axis.y, axis.x);
+		rows.Add(m_a, m_b, perp, cross(d + rA, perp), cross(rB, perp), dot(perp, d), timeStep);
+		rows.Add(m_a, m_b, vec2(0, 0), 1.0f, 1.0f, angleError, timeStep);
+		break;
+	}
+	}
+}
+
+void Joint::Draw(aie::Renderer2D* renderer)
+{
+	mat2 rotA, rotB;
+	hamh::SetRotation(rotA, m_a->GetOrient());
+	hamh::SetRotation(rotB, m_b->GetOrient());
+
+	vec2 anchorA = m_a->GetPosition() + rotA * m_localAnchorA;
+	vec2 anchorB = m_b->GetPosition() + rotB * m_localAnchorB;
+
+	renderer->setRenderColour(0.5f, 0.5f, 0.5f);
+	renderer->drawLine(m_a->GetPosition().x, m_a->GetPosition().y, anchorA.x, anchorA.y);
+	renderer->drawLine(anchorA.x, anchorA.y, anchorB.x, anchorB.y);
+	renderer->drawLine(anchorB.x, anchorB.y, m_b->GetPosition().x, m_b->GetPosition().y);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <LinearArena.h>
+
+#include "Rigidbody.h"
+
+enum class JointType : uint8_t
+{
+	JT_DISTANCE,		// Keeps anchors a fixed distance apart
+	JT_REVOLUTE,		// Pins anchors together, free to rotate
+	JT_PRISMATIC,		// Slides along an axis fixed to A, without relative rotation
+	JT_WELD				// Pins anchors & relative rotation
+};
+
+// Fraction of joint error corrected each step
+const float JOINT_BAUMGARTE = 0.2f;
+
+// Scalar constraint rows stored SoA, grouped into batches that share no dynamic body
+// Jacobian is [-n, -angularA, n, angularB], so Cdot = n.(vB - vA) + angularB * wB - angularA * wA
+struct JointRows
+{
+	Rigidbody** bodyA = nullptr;
+	Rigidbody** bodyB = nullptr;
+	float* normalX = nullptr;
+	float* normalY = nullptr;
+	float* angularA = nullptr;
+	float* angularB = nullptr;
+	float* effectiveMass = nullptr;
+	float* bias = nullptr;
+	uint32_t rowCount = 0;
+
+	// First row of each joint in batch order, plus one past the end
+	uint32_t* jointRowStart = nullptr;
+	// First joint of each batch, plus one past the end
+	uint32_t* batchStart = nullptr;
+	uint32_t batchCount = 0;
+
+	// Arrays live in the step arena, so are released with it
+	void Allocate(aie::LinearArena& arena, uint32_t rows, uint32_t joints, uint32_t batches);
+	void Add(Rigidbody* a, Rigidbody* b, const vec2& n, float angA, float angB, float error, float timeStep);
+	uint32_t GetRowCount() { return rowCount; }
+
+	// Solves every row of a joint against current body velocities
+	void SolveJoint(uint32_t joint);
+};
+
+// Constraint between two bodies, solved alongside contacts
+class Joint
+{
+public:
+	// Anchors & axis are in world space at creation
+	// Distance joints use both anchors, every other type pins at a_anchorA
+	Joint(JointType a_type, Rigidbody* a_a, Rigidbody* a_b, vec2 a_anchorA, vec2 a_anchorB, vec2 a_axis = vec2(1, 0));
+
+	JointType GetType() { return m_type; }
+	Rigidbody* GetBodyA() { return m_a; }
+	Rigidbody* GetBodyB() { return m_b; }
+
+	// Rows this joint writes each step
+	uint32_t GetRowCount();
+
+	// Writes this joint's rows for the coming step
+	void BuildRows(JointRows& rows, float timeStep);
+
+	void Draw(aie::Renderer2D* renderer);
+
+private:
+	JointType m_type;
+
+	Rigidbody* m_a;
+	Rigidbody* m_b;
+
+	// Anchors relative to each body
+	vec2 m_localAnchorA;
+	vec2 m_localAnchorB;
+	// Slide axis in A's frame
+	vec2 m_localAxis;
+
+	float m_length;
+	float m_referenceAngle;
+};
@@ -1,11 +1,15 @@
 #include "Line.h"
 
-Line::Line(vec2 a_begin, vec2 a_end, float a_restitution, Colour a_col) : Rigidbody(ShapeType::ST_LINE, a_begin, vec2(), Material(0.f, a_restitution), a_col)
+Line::Line(vec2 a_begin, vec2 a_end, MaterialID a_mat, Colour a_col) : Rigidbody(ShapeType::ST_LINE, a_begin, vec2(), a_mat, a_col)
 {
 	// m_position == begin
 	m_end = a_end;
 	// Store line length for an easier time during collision detection
 	m_length = distance(a_begin, a_end);
+	// Position is the beginning of the line, so the whole length is needed to bound it
+	m_boundingRadius = m_length;
+	// Lines are defined by their end points, never rotating
+	m_hasOrient = false;
 }
 
 void Line::Draw(aie::Renderer2D* renderer)
@@ -5,14 +5,14 @@
 class Line : public Rigidbody
 {
 public:
-	Line(vec2 a_begin, vec2 a_end, float a_restitution, Colour a_col);
+	Line(vec2 a_begin, vec2 a_end, MaterialID a_mat, Colour a_col);
 
 	virtual void Draw(aie::Renderer2D* renderer);
 
 	const vec2& GetEnd() { return m_end; }
 	float GetLength() { return m_length; }
 
-	virtual void SetOrient(float radians) {}
+	virtual vec2 GetWorldSupport(const vec2& dir) { return dot(m_position, dir) > dot(m_end, dir) ? m_position : m_end; }
 
 private:
 	// m_position == begin
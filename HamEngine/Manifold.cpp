@@ -1,23 +1,175 @@
 #include "Manifold.h"
+#include "GJK.h"
 
-bool Manifold::Solve()
+template<size_t... Pairs>
+constexpr std::array<fn, sizeof...(Pairs)> MakeColliderTable(std::index_sequence<Pairs...>)
 {
-	// Get accessor to use correct collision detection function
-	unsigned short accessor = (unsigned short)a->GetShape() * (unsigned short)ShapeType::ST_SHAPE_COUNT + (unsigned short)b->GetShape();
-	return colliderFunctionArray[accessor](this, a, b);
+	return {{ GetCollider((uint16_t)Pairs)... }};
 }
 
-void Manifold::Initialise(const vec2& gravity, float timeStep)
+// 2D array of all potential collision occurences, generated at compile time
+static constexpr std::array<fn, SHAPE_PAIR_COUNT> colliderFunctionArray = MakeColliderTable(std::make_index_sequence<SHAPE_PAIR_COUNT>());
+
+// Out of line definitions, required pre C++17 for static constexpr members used by reference
+constexpr float Manifold::m_percent;
+constexpr float Manifold::m_slop;
+constexpr float Manifold::m_speculativeDistance;
+constexpr float Manifold::m_coplanarCos;
+constexpr float Manifold::m_mergeDistance;
+
+void Manifold::Collide(Rigidbody* a, Rigidbody* b, std::vector<Manifold>& contacts)
+{
+	// Most pairs are far apart, reject them before any other work
+	float radii = a->GetBoundingRadius() + b->GetBoundingRadius() + m_speculativeDistance;
+	if (distance2(a->GetPosition(), b->GetPosition()) > hamh::sqr(radii))
+		return;
+
+	size_t first = contacts.size();
+	CollideChildren(a, a, b, b, contacts);
+
+	if (contacts.size() == first)
+		return;
+
+	// Mixed coefficients come straight from the registry
+	const MaterialMix& mix = materials::Mix(a->GetMaterial(), b->GetMaterial());
+
+#ifdef MF_CONTACTREDUCTION
+	ReduceContacts(contacts, first);
+#endif
+
+	for (size_t i = first; i < contacts.size(); ++i)
+	{
+		Manifold& m = contacts[i];
+		m.m_bodyA = a->GetSceneIndex();
+		m.m_bodyB = b->GetSceneIndex();
+		m.m_restitution = mix.restitution;
+		m.m_staFriction = mix.staticFriction;
+		m.m_dynFriction = mix.dynamicFriction;
+	}
+}
+
+void Manifold::ReduceContacts(std::vector<Manifold>& contacts, size_t first)
 {
-	//// Get minimum restitution
-	// m_restitution = min(a->GetMaterial().restitution, b->GetMaterial().restitution);
+	// Manifolds without points have nothing to fold, & their stale points mustn't be picked up
+	for (size_t i = first; i < contacts.size();)
+	{
+		if (contacts[i].m_contactCount == 0)
+		{
+			contacts[i] = contacts.back();
+			contacts.pop_back();
+		}
+		else
+			++i;
+	}
+
+	for (size_t i = first; i < contacts.size(); ++i)
+	{
+		Manifold& base = contacts[i];
+		vec2 tangent(-base.m_normal.y, base.m_normal.x);
+
+		// Gather every point on the same plane as base, from later manifolds too
+		vec2 minPoint = base.m_contacts[0], maxPoint = base.m_contacts[0];
+		float minT = dot(tangent, minPoint), maxT = minT;
+		auto addPoints = [&](const Manifold& m)
+		{
+			for (uint8_t p = 0; p < m.m_contactCount; ++p)
+			{
+				float t = dot(tangent, m.m_contacts[p]);
+				if (t < minT) { minT = t; minPoint = m.m_contacts[p]; }
+				if (t > maxT) { maxT = t; maxPoint = m.m_contacts[p]; }
+			}
+		};
+		addPoints(base);
+
+		for (size_t j = i + 1; j < contacts.size();)
+		{
+			if (dot(base.m_normal, contacts[j].m_normal) < m_coplanarCos)
+			{
+				++j;
+				continue;
+			}
+			addPoints(contacts[j]);
+			base.m_penetration = max(base.m_penetration, contacts[j].m_penetration);
+			contacts[j] = contacts.back();
+			contacts.pop_back();
+		}
+
+		// Span of the merged patch, collapsing to its centre when tiny
+		if (maxT - minT < m_mergeDistance)
+		{
+			base.m_contacts[0] = (minPoint + maxPoint) * 0.5f;
+			base.m_contactCount = 1;
+		}
+		else
+		{
+			base.m_contacts[0] = minPoint;
+			base.m_contacts[1] = maxPoint;
+			base.m_contactCount = 2;
+		}
+	}
+}
 
-	// Get average restitution
-	m_restitution = (a->GetMaterial().restitution + b->GetMaterial().restitution) / 2.0f;
+void Manifold::CollideChildren(Rigidbody* a, Rigidbody* ownerA, Rigidbody* b, Rigidbody* ownerB, std::vector<Manifold>& contacts)
+{
+	// Descend into compounds, only visiting children near the other shape
+	if (a->GetShape() == ShapeType::ST_COMPOUND)
+	{
+		static_cast<Compound*>(a)->QueryChildren(b->GetPosition(), b->GetBoundingRadius() + m_speculativeDistance, [&](Rigidbody* child)
+		{
+			CollideChildren(child, ownerA, b, ownerB, contacts);
+		});
+		return;
+	}
+	if (b->GetShape() == ShapeType::ST_COMPOUND)
+	{
+		static_cast<Compound*>(b)->QueryChildren(a->GetPosition(), a->GetBoundingRadius() + m_speculativeDistance, [&](Rigidbody* child)
+		{
+			CollideChildren(a, ownerA, child, ownerB, contacts);
+		});
+		return;
+	}
 
-	// Get frictions
-	m_staFriction = sqrt(a->GetStaticFriction() * b->GetStaticFriction());
-	m_dynFriction = sqrt(a->GetDynamicFriction() * b->GetDynamicFriction());
+	// Contacts are in world space, so they apply to the owners unchanged
+	Manifold m;
+	if (m.Solve(a, b))
+		contacts.emplace_back(m);
+}
+
+bool Manifold::Solve(Rigidbody* a, Rigidbody* b)
+{
+	// Reject pairs whose bounding circles don't overlap before any shape specific test
+	float radii = a->GetBoundingRadius() + b->GetBoundingRadius() + m_speculativeDistance;
+	if (distance2(a->GetPosition(), b->GetPosition()) > hamh::sqr(radii))
+		return false;
+
+	// Hottest pairs are called directly, skipping the table lookup
+	switch (a->GetShape())
+	{
+	case ShapeType::ST_SPHERE:
+		if (b->GetShape() == ShapeType::ST_SPHERE)
+			return sphere2Sphere(this, a, b);
+		if (b->GetShape() == ShapeType::ST_POLYGON)
+			return sphere2Polygon(this, a, b);
+		break;
+	case ShapeType::ST_POLYGON:
+		if (b->GetShape() == ShapeType::ST_SPHERE)
+			return polygon2Sphere(this, a, b);
+		if (b->GetShape() == ShapeType::ST_POLYGON)
+			return polygon2Polygon(this, a, b);
+		break;
+	default:
+		break;
+	}
+
+	return colliderFunctionArray[ShapePairIndex(a->GetShape(), b->GetShape())](this, a, b);
+}
+
+void Manifold::Initialise(Rigidbody* const* bodies, const vec2& gravity, float timeStep)
+{
+	Rigidbody* a = bodies[m_bodyA];
+	Rigidbody* b = bodies[m_bodyB];
+
+	m_hasImpulse = false;
 
 	// Contact point counting
 	for (size_t i = 0; i < m_contactCount; ++i)
@@ -35,19 +187,22 @@ void Manifold::Initialise(const vec2& gravity, float timeStep)
 	}
 }
 
-void Manifold::ApplyImpulse()
+void Manifold::ApplyImpulse(Rigidbody* const* bodies, float invTimeStep)
 {
+	Rigidbody* a = bodies[m_bodyA];
+	Rigidbody* b = bodies[m_bodyB];
+
 	// Check if objects are both static to exit early
+	// Left untouched, as static bodies may be shared by contacts solved in parallel
 	if (epsilonEqual(a->GetMassData().iMass + b->GetMassData().iMass, 0.0f, epsilon<float>()))
-	{
-		a->SetVelocity(vec2(0, 0));
-		b->SetVelocity(vec2(0, 0));
 		return;
-	}
 
 	// Convert here so it doesn't have to be done multiple times
 	float contactCount = (float)m_contactCount;
 
+	// Speculative contacts allow closing the remaining gap this step, only faster approaches are stopped
+	float gapSpeed = max(-m_penetration, 0.0f) * invTimeStep;
+
 	for (size_t i = 0; i < m_contactCount; ++i)
 	{
 
@@ -59,8 +214,8 @@ void Manifold::ApplyImpulse()
 		// Relative velocity along normal
 		float contactV = dot(relativeV, m_normal);
 
-		// Cancel if velocities seperate object
-		if (contactV > 0)
+		// Cancel if velocities seperate object, or won't close the gap before the next step
+		if (contactV + gapSpeed > 0)
 			return;
 
 		float radiusACrossNormal = cross(radiusA, m_normal);
@@ -68,15 +223,22 @@ void Manifold::ApplyImpulse()
 		float invMassSum = a->GetMassData().iMass + b->GetMassData().iMass + hamh::sqr(radiusACrossNormal) * a->GetMassData().iInertia + hamh::sqr(radiusBCrossNormal) * b->GetMassData().iInertia;
 
 		// Impulse scalar calculation
-		float j = -(1.0f + m_restitution) * contactV;
+		// Inelastic speculative contacts stop exactly at the surface, bouncy ones rebound as if touching
+		float j = (m_restitution > 0.0f || gapSpeed == 0.0f) ? -(1.0f + m_restitution) * contactV : -(contactV + gapSpeed);
 		j /= invMassSum;
 		j /= contactCount;
+		if (j > 0.0f)
+			m_hasImpulse = true;
 
 		// Apply impulse
 		vec2 impulse = m_normal * j;
 		a->ApplyImpulse(-impulse, radiusA);
 		b->ApplyImpulse(impulse, radiusB);
 
+		// Speculative contacts aren't touching yet, so have no surface to rub against
+		if (m_penetration < 0.0f || j <= 0.0f)
+			continue;
+
 		// Friction impulse
 		// Disabled due to excessive errors
 		// Recalculate relativeV for friction
@@ -108,13 +270,28 @@ void Manifold::ApplyImpulse()
 	}
 }
 
-void Manifold::PositionalCorrection()
+void Manifold::PositionalCorrection(Rigidbody* const* bodies, float relaxation)
 {
-	vec2 correction = max(m_penetration - m_slop, 0.0f) / (a->GetMassData().iMass + b->GetMassData().iMass) * m_normal * m_percent;
+	Rigidbody* a = bodies[m_bodyA];
+	Rigidbody* b = bodies[m_bodyB];
+
+	// Nothing to push apart, speculative contacts mustn't count as hits either
+	if (m_penetration <= m_slop)
+		return;
+
+	vec2 correction = (m_penetration - m_slop) / (a->GetMassData().iMass + b->GetMassData().iMass) * m_normal * (m_percent * relaxation);
 	a->AddPosition(-(correction * a->GetMassData().iMass));
 	b->AddPosition(correction * b->GetMassData().iMass);
 }
 
+void Manifold::UpdatePenetration(Rigidbody* const* bodies, const vec2* previousPositions)
+{
+	// Translation only, rotation over a sub-step is small enough to ignore
+	vec2 moveA = bodies[m_bodyA]->GetPosition() - previousPositions[m_bodyA];
+	vec2 moveB = bodies[m_bodyB]->GetPosition() - previousPositions[m_bodyB];
+	m_penetration -= dot(moveB - moveA, m_normal);
+}
+
 #pragma region CollisionDetectionFunc
 
 bool Manifold::sphere2Sphere(Manifold* manifold, Rigidbody* body1, Rigidbody* body2)
@@ -129,7 +306,7 @@ bool Manifold::sphere2Sphere(Manifold* manifold, Rigidbody* body1, Rigidbody* bo
 	float radTotal = s1->GetRadius() + s2->GetRadius();
 
 	// No contact
-	if (distSqr >= hamh::sqr(radTotal))
+	if (distSqr >= hamh::sqr(radTotal + m_speculativeDistance))
 	{
 		manifold->m_contactCount = 0;
 		return false;
@@ -162,9 +339,8 @@ bool Manifold::sphere2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody* b
 
 	manifold->m_contactCount = 0;
 
-	// transform circle center to polygon model space
+	// Work in world space using the polygon's cached vertices & normals
 	vec2 center = sphere->GetPosition();
-	center = transpose(polygon->GetRotationMatrix()) * (center - body2->GetPosition());
 
 	// find edge with minimum penetration
 	// exact concept as using support points in polygon2Polygon
@@ -172,11 +348,9 @@ bool Manifold::sphere2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody* b
 	uint32_t faceNormal = 0;
 	for (uint32_t i = 0; i < polygon->GetVertexCount(); ++i)
 	{
-		vec2 vert = polygon->GetVertex(i);
-		vec2 norm = polygon->GetNormal(i);
-		float s = dot(norm, center - vert);
+		float s = dot(polygon->GetWorldNormal(i), center - polygon->GetWorldVertex(i));
 
-		if (s > sphere->GetRadius())
+		if (s > sphere->GetRadius() + m_speculativeDistance)
 			return false;
 
 		if (s > separation)
@@ -187,15 +361,15 @@ bool Manifold::sphere2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody* b
 	}
 
 	// Grab face's vertices
-	vec2 v1 = polygon->GetVertex(faceNormal);
+	vec2 v1 = polygon->GetWorldVertex(faceNormal);
 	uint32_t i2 = faceNormal + 1 < polygon->GetVertexCount() ? faceNormal + 1 : 0;
-	vec2 v2 = polygon->GetVertex(i2);
+	vec2 v2 = polygon->GetWorldVertex(i2);
 
 	// check to see if center is within polygon
 	if (separation < epsilon<float>())
 	{
 		manifold->m_contactCount = 1;
-		manifold->m_normal = -(polygon->GetRotationMatrix() * polygon->GetNormal(faceNormal));
+		manifold->m_normal = -polygon->GetWorldNormal(faceNormal);
 		manifold->m_contacts[0] = manifold->m_normal * sphere->GetRadius() + sphere->GetPosition();
 		manifold->m_penetration = sphere->GetRadius();
 		return true;
@@ -209,37 +383,34 @@ bool Manifold::sphere2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody* b
 	// closest to V1
 	if (dot1 < 0.0f)
 	{
-		if (distance2(center, v1) > hamh::sqr(sphere->GetRadius()))
+		float dist = distance(center, v1);
+		if (dist > sphere->GetRadius() + m_speculativeDistance)
 			return false;
 
 		manifold->m_contactCount = 1;
-		vec2 n = v1 - center;
-		n = polygon->GetRotationMatrix() * n;
-		manifold->m_normal = normalize(n);
-		v1 = polygon->GetRotationMatrix() * v1 + polygon->GetPosition();
+		manifold->m_normal = (v1 - center) / dist;
 		manifold->m_contacts[0] = v1;
+		manifold->m_penetration = sphere->GetRadius() - dist;
 	}
 	// Closest to V2
 	else if (dot2 <= 0.0f)
 	{
-		if (distance2(center, v2) > hamh::sqr(sphere->GetRadius()))
+		float dist = distance(center, v2);
+		if (dist > sphere->GetRadius() + m_speculativeDistance)
 			return false;
 
 		manifold->m_contactCount = 1;
-		vec2 n = v2 - center;
-		v2 = polygon->GetRotationMatrix() * v2 + polygon->GetPosition();
 		manifold->m_contacts[0] = v2;
-		n = polygon->GetRotationMatrix() * n;
-		manifold->m_normal = normalize(n);
+		manifold->m_normal = (v2 - center) / dist;
+		manifold->m_penetration = sphere->GetRadius() - dist;
 	}
 	// Closest to face
 	else
 	{
-		vec2 n = polygon->GetNormal(faceNormal);
-		if (dot(center - v1, n) > sphere->GetRadius())
+		vec2 n = polygon->GetWorldNormal(faceNormal);
+		if (dot(center - v1, n) > sphere->GetRadius() + m_speculativeDistance)
 			return false;
 
-		n = polygon->GetRotationMatrix() * n;
 		manifold->m_normal = -n;
 		manifold->m_contacts[0] = manifold->m_normal * sphere->GetRadius() + sphere->GetPosition();
 		manifold->m_contactCount = 1;
@@ -252,8 +423,8 @@ bool Manifold::sphere2Line(Manifold* manifold, Rigidbody* body1, Rigidbody* body
 	Sphere* sphere = static_cast<Sphere*>(body1);
 	Line* line = static_cast<Line*>(body2);
 
-	// sqr Radius
-	float radiusSqr = hamh::sqr(sphere->GetRadius());
+	// sqr Radius, widened to catch speculative contacts
+	float radiusSqr = hamh::sqr(sphere->GetRadius() + m_speculativeDistance);
 
 	// sqr distances between sphere & ends of line
 	// Early exit if sphere collides with either of the end points of line
@@ -285,7 +456,7 @@ bool Manifold::sphere2Line(Manifold* manifold, Rigidbody* body1, Rigidbody* body
 	}
 
 	// Find closest point on line to sphere
-	float sphereProjection = dot(sphere->GetPosition() - line->GetPosition(), line->GetEnd() - line->GetPosition()) / powf(line->GetLength(), 2);
+	float sphereProjection = dot(sphere->GetPosition() - line->GetPosition(), line->GetEnd() - line->GetPosition()) / hamh::sqr(line->GetLength());
 	vec2 spherePoint = line->GetPosition() + (sphereProjection * (line->GetEnd() - line->GetPosition()));
 
 	// if point isn't on line, exit early
@@ -327,13 +498,13 @@ bool Manifold::polygon2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody*
 	// Check for a separating axis with 1's face planes
 	uint32_t faceA;
 	float penetrationA = FindAxisLeastPenetration(&faceA, poly1, poly2);
-	if (penetrationA >= 0.0f)
+	if (penetrationA >= m_speculativeDistance)
 		return false;
 
 	// check for a separating axis with 2's face planes
 	uint32_t faceB;
 	float penetrationB = FindAxisLeastPenetration(&faceB, poly2, poly1);
-	if (penetrationB >= 0.0f)
+	if (penetrationB >= m_speculativeDistance)
 		return false;
 
 	uint32_t referenceIndex;
@@ -361,14 +532,10 @@ bool Manifold::polygon2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody*
 	vec2 incidentFace[2];
 	FindIncidentFace(incidentFace, refPoly, incPoly, referenceIndex);
 
-	// Setup reference face vertices
-	vec2 v1 = refPoly->GetVertex(referenceIndex);
+	// Setup reference face vertices in world space
+	vec2 v1 = refPoly->GetWorldVertex(referenceIndex);
 	referenceIndex = referenceIndex + 1 == refPoly->GetVertexCount() ? 0 : referenceIndex + 1;
-	vec2 v2 = refPoly->GetVertex(referenceIndex);
-
-	// transform verices to world space
-	v1 = refPoly->GetRotationMatrix() * v1 + refPoly->GetPosition();
-	v2 = refPoly->GetRotationMatrix() * v2 + refPoly->GetPosition();
+	vec2 v2 = refPoly->GetWorldVertex(referenceIndex);
 
 	// Calculate reference face side normal in world space
 	vec2 sidePlaneNormal = normalize(v2 - v1);
@@ -392,10 +559,10 @@ bool Manifold::polygon2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody*
 	// Flip
 	manifold->m_normal = flip ? -refFaceNormal : refFaceNormal;
 
-	// keep points behind reference face
+	// keep points behind reference face, or within speculative distance of it
 	uint32_t cp = 0; // clipped points behind reference face
 	float separation = dot(refFaceNormal, incidentFace[0]) - refC;
-	if (separation <= 0.0f)
+	if (separation <= m_speculativeDistance)
 	{
 		manifold->m_contacts[cp] = incidentFace[0];
 		manifold->m_penetration = -separation;
@@ -405,7 +572,7 @@ bool Manifold::polygon2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody*
 		manifold->m_penetration = 0;
 
 	separation = dot(refFaceNormal, incidentFace[1]) - refC;
-	if (separation <= 0.0f)
+	if (separation <= m_speculativeDistance)
 	{
 		manifold->m_contacts[cp] = incidentFace[1];
 		manifold->m_penetration += -separation;
@@ -416,12 +583,8 @@ bool Manifold::polygon2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody*
 	}
 	
 	manifold->m_contactCount = cp;
-	return true;
-}
-
-bool Manifold::polygon2Line(Manifold* manifold, Rigidbody* body1, Rigidbody* body2)
-{
-	return false;
+	// Clipping can leave nothing within range
+	return cp > 0;
 }
 
 bool Manifold::line2Sphere(Manifold* manifold, Rigidbody* body1, Rigidbody* body2)
@@ -431,14 +594,28 @@ bool Manifold::line2Sphere(Manifold* manifold, Rigidbody* body1, Rigidbody* body
 	return success;
 }
 
-bool Manifold::line2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody* body2)
+bool Manifold::convex2Convex(Manifold* manifold, Rigidbody* body1, Rigidbody* body2)
 {
-	return false;
-}
+	manifold->m_contactCount = 0;
 
-bool Manifold::line2Line(Manifold* manifold, Rigidbody* body1, Rigidbody* body2)
-{
-	return false;
+	GJKResult result = gjk::Query(body1, body2);
+
+	float radius1 = body1->GetSupportRadius();
+	float radius2 = body2->GetSupportRadius();
+
+	// Separated cores only collide through their rounding
+	if (!result.overlapping && result.distance >= radius1 + radius2 + m_speculativeDistance)
+		return false;
+
+	manifold->m_normal = result.normal;
+	manifold->m_penetration = result.overlapping ? result.distance + radius1 + radius2 : radius1 + radius2 - result.distance;
+
+	// Contact halfway between the two surfaces
+	vec2 surface1 = result.pointA + result.normal * radius1;
+	vec2 surface2 = result.pointB - result.normal * radius2;
+	manifold->m_contacts[0] = (surface1 + surface2) * 0.5f;
+	manifold->m_contactCount = 1;
+	return true;
 }
 
 float Manifold::FindAxisLeastPenetration(uint32* faceIndex, Polygon* body1, Polygon* body2)
@@ -448,25 +625,13 @@ float Manifold::FindAxisLeastPenetration(uint32* faceIndex, Polygon* body1, Poly
 
 	for (uint32_t i = 0; i < body1->GetVertexCount(); ++i)
 	{
-		// Retrieve face normal from A
-		vec2 n = body1->GetNormal(i);
-		vec2 nw = body1->GetRotationMatrix() * n;
-
-		// Transform face normal into body2's model space
-		mat2 buT = transpose(body2->GetRotationMatrix());
-		n = buT * nw;
-
-		// Retrieve support point from body2 along -n
-		vec2 s = body2->GetSupport(-n);
+		// Retrieve world face normal & vertex on face from A
+		vec2 n = body1->GetWorldNormal(i);
+		vec2 v = body1->GetWorldVertex(i);
 
-		// retrieve vertex on face from body1, transform to body2's model space
-		vec2 v = body1->GetVertex(i);
-		v = body1->GetRotationMatrix() * v + body1->GetPosition();
-		v -= body2->GetPosition();
-		v = buT * v;
-
-		// compute penetration distance (in body2's model space)
-		float d = dot(n, s - v);
+		// Penetration distance to body2's support point along -n
+		// Support projection is the smallest projection along n
+		float d = body2->GetMinProjection(n) - dot(n, v);
 
 		// store greatest distance
 		if (d > bestDistance)
@@ -481,18 +646,14 @@ float Manifold::FindAxisLeastPenetration(uint32* faceIndex, Polygon* body1, Poly
 
 void Manifold::FindIncidentFace(vec2* v, Polygon* refPoly, Polygon* incPoly, uint32_t referenceIndex)
 {
-	vec2 referenceNormal = refPoly->GetNormal(referenceIndex);
-
-	// calculate normal in incident's frame of reference
-	referenceNormal = refPoly->GetRotationMatrix() * referenceNormal;
-	referenceNormal = transpose(incPoly->GetRotationMatrix()) * referenceNormal;
+	vec2 referenceNormal = refPoly->GetWorldNormal(referenceIndex);
 
 	// Find most anti-normal face on incident polygon
 	uint32_t incidentFace = 0;
 	float minDot = FLT_MAX;
 	for (uint32_t i = 0; i < incPoly->GetVertexCount(); ++i)
 	{
-		float d = dot(referenceNormal, incPoly->GetNormal(i));
+		float d = dot(referenceNormal, incPoly->GetWorldNormal(i));
 		if (d < minDot)
 		{
 			minDot = d;
@@ -501,9 +662,9 @@ void Manifold::FindIncidentFace(vec2* v, Polygon* refPoly, Polygon* incPoly, uin
 	}
 
 	// assign face vertices for incidentface
-	v[0] = incPoly->GetRotationMatrix() * incPoly->GetVertex(incidentFace) + incPoly->GetPosition();
+	v[0] = incPoly->GetWorldVertex(incidentFace);
 	incidentFace = incidentFace + 1 >= incPoly->GetVertexCount() ? 0 : incidentFace + 1;
-	v[1] = incPoly->GetRotationMatrix() * incPoly->GetVertex(incidentFace) + incPoly->GetPosition();
+	v[1] = incPoly->GetWorldVertex(incidentFace);
 }
 
 uint32_t Manifold::Clip(vec2 n, float c, vec2* face)
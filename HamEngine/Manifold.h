@@ -1,23 +1,51 @@
 #pragma once
 
+#include <array>
+#include <utility>
+
 #include "Sphere.h"
 #include "Polygon.h"
 #include "Line.h"
+#include "Capsule.h"
+#include "Compound.h"
 
 const float PLBUFFER = 0.1f;
 
+// Generates contacts for shapes about to touch, letting the velocity solve stop them before they overlap
+// Comment out to only generate contacts between overlapping shapes
+#define MF_SPECULATIVE
+
+// Merges each pair's near coplanar contacts before solving, cutting solver work in dense piles
+// Comment out to solve every generated contact
+#define MF_CONTACTREDUCTION
+
 // Resolves collisions between objects
+// Kept compact for the solver, bodies are referenced by scene index & materials are mixed up front
 class Manifold
 {
 public:
-	Manifold(Rigidbody* a_a, Rigidbody* a_b) : a(a_a), b(a_b) {}
+	// Generates contacts between two bodies in the scene, appending any found
+	// Compounds produce a manifold per touching child, applied to the compound itself
+	static void Collide(Rigidbody* a, Rigidbody* b, std::vector<Manifold>& contacts);
 
-	bool Solve();
-	void Initialise(const vec2& gravity, float timeStep);
-	void ApplyImpulse();
-	void PositionalCorrection();
+	// Narrowphase between two shapes, filling in normal, penetration & contact points
+	bool Solve(Rigidbody* a, Rigidbody* b);
+
+	// Solver stages, given the scene's body list the indices refer to
+	void Initialise(Rigidbody* const* bodies, const vec2& gravity, float timeStep);
+	void ApplyImpulse(Rigidbody* const* bodies, float invTimeStep);
+	// Relaxation scales the correction, so sub-steps can share one step's worth between them
+	void PositionalCorrection(Rigidbody* const* bodies, float relaxation = 1.0f);
+	// Moves penetration along with the bodies since they were at previousPositions, avoiding a new narrowphase
+	void UpdatePenetration(Rigidbody* const* bodies, const vec2* previousPositions);
 
 	vec2 GetContact() { return m_contacts[0]; }
+	// Gap below which shapes generate contacts
+	static float GetSpeculativeDistance() { return m_speculativeDistance; }
+	uint32_t GetBodyA() { return m_bodyA; }
+	uint32_t GetBodyB() { return m_bodyB; }
+	// True if the solver pushed the bodies apart this step
+	bool HasImpulse() { return m_hasImpulse; }
 
 	// Collision detection for each object on each other object
 #pragma region CollisionDetectionFunc
@@ -27,10 +55,10 @@ public:
 	static bool sphere2Line(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
 	static bool polygon2Sphere(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
 	static bool polygon2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
-	static bool polygon2Line(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
 	static bool line2Sphere(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
-	static bool line2Polygon(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
-	static bool line2Line(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
+
+	// Generic GJK/EPA path for any pair of convex shapes without a dedicated routine
+	static bool convex2Convex(Manifold* manifold, Rigidbody* body1, Rigidbody* body2);
 
 	// Extra functions specifically for polygon collision detection assistance
 	static float FindAxisLeastPenetration(uint32* faceIndex, Polygon* body1, Polygon* body2);
@@ -40,34 +68,68 @@ public:
 #pragma endregion
 
 private:
-	Rigidbody* a;
-	Rigidbody* b;
+	static void CollideChildren(Rigidbody* a, Rigidbody* ownerA, Rigidbody* b, Rigidbody* ownerB, std::vector<Manifold>& contacts);
+
+	// Folds a pair's manifolds sharing a normal into the first, keeping the two extreme points
+	static void ReduceContacts(std::vector<Manifold>& contacts, size_t first);
+
+	uint32_t m_bodyA = 0;
+	uint32_t m_bodyB = 0;
 
-	float m_penetration = 0.f;		// Depth of penetration
 	vec2 m_normal = vec2();			// A -> B
+	float m_penetration = 0.f;		// Depth of penetration, negative for speculative contacts
 	vec2 m_contacts[2] = {};		// Points of contact
-	uint32_t m_contactCount = 0U;	// Contact total during collision
-
 
 	// Mixed variables for equations
 	float m_restitution = 0.f;	// Restitution
 	float m_dynFriction = 0.f;	// dynamic friction
 	float m_staFriction = 0.f;	// static friction
 
+	uint8_t m_contactCount = 0U;	// Contact total during collision
+	bool m_hasImpulse = false;		// Set by ApplyImpulse, bodies are told once solving is done
+
 	// Linear projection values
-	const float m_percent = 0.2f;
-	const float m_slop = 0.05f;
+	static constexpr float m_percent = 0.2f;
+	static constexpr float m_slop = 0.05f;
+
+	// Shapes closer than this generate contacts, bodies may close the gap but not overlap
+#ifdef MF_SPECULATIVE
+	static constexpr float m_speculativeDistance = 4.0f;
+#else
+	static constexpr float m_speculativeDistance = 0.0f;
+#endif
+
+	// Normals closer than this (cosine) are treated as the same plane by contact reduction
+	static constexpr float m_coplanarCos = 0.998f;
+	// Points closer than this are merged into one
+	static constexpr float m_mergeDistance = 0.5f;
 };
 
 // Collision detection functions
 // Returns true if collision has occured
 typedef bool(*fn)(Manifold*, Rigidbody*, Rigidbody*);
 
-// 2D array of all potential collision occurences
-// Top-right are the functions; bottom left are redirectors
-static fn colliderFunctionArray[]
+constexpr uint16_t SHAPE_PAIR_COUNT = (uint16_t)ShapeType::ST_SHAPE_COUNT * (uint16_t)ShapeType::ST_SHAPE_COUNT;
+
+// Index of a shape pair within the collider table, A major
+constexpr uint16_t ShapePairIndex(ShapeType a, ShapeType b)
+{
+	return (uint16_t)a * (uint16_t)ShapeType::ST_SHAPE_COUNT + (uint16_t)b;
+}
+
+// Collision function for every potential collision occurence
+// Pairs with a dedicated routine are listed, everything else uses GJK/EPA
+// so new shapes only need a support function
+constexpr fn GetCollider(uint16_t pairIndex)
 {
-	Manifold::sphere2Sphere,		Manifold::sphere2Polygon,		Manifold::sphere2Line,
-	Manifold::polygon2Sphere,		Manifold::polygon2Polygon,		Manifold::polygon2Line,
-	Manifold::line2Sphere,			Manifold::line2Polygon,			Manifold::line2Line
-};
\ No newline at end of file
+	switch (pairIndex)
+	{
+	case ShapePairIndex(ShapeType::ST_SPHERE, ShapeType::ST_SPHERE):	return Manifold::sphere2Sphere;
+	case ShapePairIndex(ShapeType::ST_SPHERE, ShapeType::ST_POLYGON):	return Manifold::sphere2Polygon;
+	case ShapePairIndex(ShapeType::ST_SPHERE, ShapeType::ST_LINE):		return Manifold::sphere2Line;
+	case ShapePairIndex(ShapeType::ST_POLYGON, ShapeType::ST_SPHERE):	return Manifold::polygon2Sphere;
+	case ShapePairIndex(ShapeType::ST_POLYGON, ShapeType::ST_POLYGON):	return Manifold::polygon2Polygon;
+	case ShapePairIndex(ShapeType::ST_LINE, ShapeType::ST_SPHERE):		return Manifold::line2Sphere;
+	default:															return Manifold::convex2Convex;
+	}
+}
@@ -0,0 +1,80 @@
+#include "Material.h"
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+
+namespace
+{
+	uint32_t g_count = 0;
+	Material g_materials[MAT_MAXMATERIALS];
+	MaterialMix g_mix[MAT_MAXMATERIALS][MAT_MAXMATERIALS];
+
+	MaterialID Add(const Material& material)
+	{
+		MaterialID id = (MaterialID)g_count++;
+		g_materials[id] = material;
+
+		// Fill in the new row & column, table is symmetric
+		for (uint32_t i = 0; i < g_count; ++i)
+		{
+			const Material& other = g_materials[i];
+			MaterialMix mix;
+			mix.restitution = (material.restitution + other.restitution) / 2.0f;
+			mix.staticFriction = sqrtf(material.staticFriction * other.staticFriction);
+			mix.dynamicFriction = sqrtf(material.dynamicFriction * other.dynamicFriction);
+			g_mix[id][i] = mix;
+			g_mix[i][id] = mix;
+		}
+		return id;
+	}
+}
+
+MaterialID materials::Register(const Material& material)
+{
+	for (uint32_t i = 0; i < g_count; ++i)
+		if (g_materials[i] == material)
+			return (MaterialID)i;
+
+	if (g_count < MAT_MAXMATERIALS)
+		return Add(material);
+
+	// Table is full, hand out the closest match rather than overrunning it
+	// Static & dynamic materials never stand in for each other, a body keeps its mobility
+	assert(!"Material table full, raise MAT_MAXMATERIALS");
+	printf("Material table full, substituting the closest of %u materials\n", g_count);
+
+	MaterialID best = 0;
+	float bestDifference = FLT_MAX;
+	for (uint32_t i = 0; i < g_count; ++i)
+	{
+		const Material& other = g_materials[i];
+		float difference = fabsf(other.density - material.density) + fabsf(other.restitution - material.restitution) +
+			fabsf(other.staticFriction - material.staticFriction) + fabsf(other.dynamicFriction - material.dynamicFriction);
+		if ((other.density == 0.0f) != (material.density == 0.0f))
+			difference += 1e6f;
+
+		if (difference < bestDifference)
+		{
+			bestDifference = difference;
+			best = (MaterialID)i;
+		}
+	}
+	return best;
+}
+
+const Material& materials::Get(MaterialID id)
+{
+	return g_materials[id];
+}
+
+const MaterialMix& materials::Mix(MaterialID a, MaterialID b)
+{
+	return g_mix[a][b];
+}
+
+uint32_t materials::GetCount()
+{
+	return g_count;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+// Most materials a scene can register, the mix table grows with the square of this
+#define MAT_MAXMATERIALS 32
+
+typedef uint16_t MaterialID;
+
+// Material for physics responses. Default is metal.
+struct Material
+{
+	Material() {}
+	Material(float d, float r, float sf = 0.4f, float df = 0.2f) { density = d; restitution = r; staticFriction = sf; dynamicFriction = df; }
+
+	bool operator==(const Material& other) const
+	{
+		return density == other.density && restitution == other.restitution &&
+			staticFriction == other.staticFriction && dynamicFriction == other.dynamicFriction;
+	}
+
+	float density = 1.2f;
+	float restitution = 0.05f;
+	float staticFriction = 0.4f;
+	float dynamicFriction = 0.2f;
+};
+
+// Response coefficients for a pair of materials, mixed ahead of time
+struct MaterialMix
+{
+	float restitution;
+	float staticFriction;
+	float dynamicFriction;
+};
+
+// Global table of materials, bodies refer to them by ID
+// Every pair is mixed on registration, so contacts only ever do a table load
+namespace materials
+{
+	// Returns the existing ID if an identical material was already registered
+	// Once the table is full, asserts & returns the closest registered material of the same static or dynamic kind
+	MaterialID Register(const Material& material);
+
+	const Material& Get(MaterialID id);
+	const MaterialMix& Mix(MaterialID a, MaterialID b);
+
+	uint32_t GetCount();
+}
@@ -1,13 +1,16 @@
 #include "PhysScene.h"
 
-PhysScene::PhysScene(float a_timeStep, vec2 a_gravity)
+PhysScene::PhysScene(float a_timeStep, vec2 a_gravity, uint32_t a_seed)
 {
 	m_timeStep = a_timeStep;
 	m_gravity = a_gravity;
+	m_rng.Seed(a_seed);
 }
 
 PhysScene::~PhysScene()
 {
+	for (Joint* joint : m_joints)
+		delete joint;
 	for (Rigidbody* body : m_rBodyList)
 		delete body;
 }
@@ -18,22 +21,32 @@ void PhysScene::Update(float deltaTime)
 	// Update once per frame for debug purposes
 	TimeStep();
 #else
-	static float accTime = 0.0f;
-	accTime += deltaTime;
+	m_accTime += deltaTime;
 
-	while (accTime >= m_timeStep)
+	while (m_accTime >= m_timeStep)
 	{
 		TimeStep();
 
-		accTime -= m_timeStep;
+		m_accTime -= m_timeStep;
 	}
 #endif
 }
 
 void PhysScene::Draw(aie::Renderer2D* renderer)
 {
-	for (Rigidbody* body : m_rBodyList)
-		body->Draw(renderer);
+	vec2 cameraPos;
+	renderer->getCameraPos(cameraPos.x, cameraPos.y);
+
+	m_drawnCount = 0;
+	QueryView(cameraPos, [&](uint32_t index)
+	{
+		m_rBodyList[index]->Draw(renderer);
+		++m_drawnCount;
+	});
+	m_culledCount = (uint32_t)m_rBodyList.size() - m_drawnCount;
+
+	for (Joint* joint : m_joints)
+		joint->Draw(renderer);
 }
 
 void PhysScene::TimeStep()
@@ -41,64 +54,371 @@ void PhysScene::TimeStep()
 	// Ensure enough objects exist to check collisions
 	size_t bodyCount = m_rBodyList.size();
 
+	// Everything allocated during the last step is finished with
+	m_stepArena.reset();
+
+	UpdateLod();
+
 	if (bodyCount > 1)
 	{
-		// New collision info set
+		if (!m_broadphaseValid)
+			BuildBroadphase();
+
+		// New collision info set, pairs are in the same order as testing every body against every later one
 		m_contacts.clear();
-		for (size_t i = 0; i < bodyCount; ++i)
+		m_broadphase.FindPairs(m_pairs);
+		for (uint64_t pair : m_pairs)
 		{
-			Rigidbody* a = m_rBodyList[i];
+			Rigidbody* a = m_rBodyList[(uint32_t)(pair >> 32)];
+			Rigidbody* b = m_rBodyList[(uint32_t)pair];
+			if (a->GetMassData().iMass == 0 && b->GetMassData().iMass == 0)
+				continue;
+			Manifold::Collide(a, b, m_contacts);
+		}
+
+		PrepareContacts();
+		PrepareJoints();
 
-			for (size_t j = i + 1; j < bodyCount; ++j)
+		// Contacts found above are reused by every sub-step, only integration & solving repeat
+		float subTimeStep = m_timeStep / m_subSteps;
+		vec2* subStepStart = (m_subSteps > 1) ? m_stepArena.allocateArray<vec2>(bodyCount) : nullptr;
+
+		for (uint32_t subStep = 0; subStep < m_subSteps; ++subStep)
+		{
+			if (subStepStart)
 			{
-				Rigidbody* b = m_rBodyList[j];
-				if (a->GetMassData().iMass == 0 && b->GetMassData().iMass == 0)
-					continue;
-				Manifold m(a, b);
-				if (m.Solve())
-					m_contacts.emplace_back(m);
+				// Bodies have moved since detection, track each contact's depth along with them
+				if (subStep > 0)
+					for (size_t i = 0; i < m_contacts.size(); ++i)
+						m_contacts[i].UpdatePenetration(m_rBodyList.data(), subStepStart);
+
+				for (size_t i = 0; i < bodyCount; ++i)
+					subStepStart[i] = m_rBodyList[i]->GetPosition();
 			}
-		}
 
-		// Integrate forces
-		for (size_t i = 0; i < bodyCount; ++i)
-			m_rBodyList[i]->IntegrateForces(m_gravity, m_timeStep);
+			// Integrate forces
+			for (size_t i = 0; i < bodyCount; ++i)
+				m_rBodyList[i]->IntegrateForces(m_gravity, subTimeStep);
 
-		// Initialise collisions
-		for (size_t i = 0; i < m_contacts.size(); ++i)
-			m_contacts[i].Initialise(m_gravity, m_timeStep);
+			// Initialise collisions, restitution is decided by the approach velocity at the start of the step
+			if (subStep == 0)
+				for (size_t i = 0; i < m_contacts.size(); ++i)
+					m_contacts[i].Initialise(m_rBodyList.data(), m_gravity, subTimeStep);
 
-		// Solve collisions
-		for (size_t i = 0; i < m_contacts.size(); ++i)
-			m_contacts[i].ApplyImpulse();
+			BuildJointRows(subTimeStep);
 
-		// Integrate velocities
-		for (size_t i = 0; i < bodyCount; ++i)
-			m_rBodyList[i]->IntegrateVelocity(m_gravity, m_timeStep);
+			// Solve collisions & joints together so each sees the other's impulses
+			for (uint32_t iteration = 0; iteration < m_iterations; ++iteration)
+			{
+				SolveContacts(1.0f / subTimeStep);
+				SolveJoints();
+			}
 
-		// Correct positions
+			// Integrate velocities
+			for (size_t i = 0; i < bodyCount; ++i)
+				m_rBodyList[i]->IntegrateVelocity(m_gravity, subTimeStep);
+
+			// Correct positions, depths are tracked between sub-steps so each corrects what is left
+			// Each sub-step takes its share, so a step corrects no harder than without sub-steps
+			for (size_t i = 0; i < m_contacts.size(); ++i)
+				m_contacts[i].PositionalCorrection(m_rBodyList.data(), 1.0f / m_subSteps);
+		}
+
+		// Solving may run in parallel, so bodies only hear about impacts once it's done
 		for (size_t i = 0; i < m_contacts.size(); ++i)
-			m_contacts[i].PositionalCorrection();
+		{
+			if (m_contacts[i].HasImpulse())
+			{
+				m_rBodyList[m_contacts[i].GetBodyA()]->OnImpact();
+				m_rBodyList[m_contacts[i].GetBodyB()]->OnImpact();
+			}
+		}
+
+		// Refresh cached world-space shape data for the next detection pass
+		UpdateOrientations();
+		for (size_t i = 0; i < bodyCount; ++i)
+			m_rBodyList[i]->UpdateWorldCache();
 
 		// Clear forces
 		for (size_t i = 0; i < bodyCount; ++i)
 			m_rBodyList[i]->ResetForce();
+
+		BuildBroadphase();
 	}
 }
 
 Rigidbody* PhysScene::AddBody(Rigidbody* body)
 {
+	body->SetSceneIndex((uint32_t)m_rBodyList.size());
 	m_rBodyList.push_back(body);
+	m_broadphaseValid = false;
 	return body;
 }
 
 void PhysScene::RemoveBody(Rigidbody* body)
+{
+	if (DetachBody(body))
+		delete body;
+}
+
+bool PhysScene::DetachBody(Rigidbody* body)
 {
 	// Remove body from list via ptr, O(n)
 	auto it = std::find(m_rBodyList.begin(), m_rBodyList.end(), body);
-	if (it != m_rBodyList.end())
+	if (it == m_rBodyList.end())
+		return false;
+
+	// Joints can't outlive their bodies
+	for (size_t i = m_joints.size(); i-- > 0;)
 	{
-		delete body;
-		m_rBodyList.erase(it);
+		if (m_joints[i]->GetBodyA() == body || m_joints[i]->GetBodyB() == body)
+		{
+			delete m_joints[i];
+			m_joints.erase(m_joints.begin() + i);
+		}
+	}
+
+	it = m_rBodyList.erase(it);
+	m_broadphaseValid = false;
+
+	// Shift indices of every body after the removed one
+	for (; it != m_rBodyList.end(); ++it)
+		(*it)->SetSceneIndex((*it)->GetSceneIndex() - 1);
+	return true;
+}
+
+void PhysScene::Snapshot(std::vector<uint8_t>& blob)
+{
+	SceneSnapshotHeader header;
+	header.bodyCount = (uint32_t)m_rBodyList.size();
+	header.accTime = m_accTime;
+	header.rng = m_rng;
+
+	// resize keeps capacity, so repeated snapshots into the same blob don't allocate
+	blob.resize(sizeof(header) + m_rBodyList.size() * sizeof(BodyState));
+	memcpy(blob.data(), &header, sizeof(header));
+
+	BodyState* states = (BodyState*)(blob.data() + sizeof(header));
+	for (size_t i = 0; i < m_rBodyList.size(); ++i)
+		states[i] = m_rBodyList[i]->GetState();
+}
+
+bool PhysScene::Restore(const std::vector<uint8_t>& blob)
+{
+	if (blob.size() < sizeof(SceneSnapshotHeader))
+		return false;
+
+	SceneSnapshotHeader header;
+	memcpy(&header, blob.data(), sizeof(header));
+	if (header.bodyCount != m_rBodyList.size() || blob.size() != sizeof(header) + header.bodyCount * sizeof(BodyState))
+		return false;
+
+	m_accTime = header.accTime;
+	m_rng = header.rng;
+
+	const BodyState* states = (const BodyState*)(blob.data() + sizeof(header));
+	for (size_t i = 0; i < m_rBodyList.size(); ++i)
+		m_rBodyList[i]->SetState(states[i]);
+	m_broadphaseValid = false;
+	return true;
+}
+
+uint64_t PhysScene::Checksum()
+{
+	// FNV-1a over raw bits, any drift at all changes the result
+	uint64_t hash = 14695981039346656037ULL;
+	auto mix = [&hash](const void* data, size_t size)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; ++i)
+			hash = (hash ^ bytes[i]) * 1099511628211ULL;
+	};
+
+	for (Rigidbody* body : m_rBodyList)
+	{
+		vec2 position = body->GetPosition();
+		vec2 velocity = body->GetVelocity();
+		float rotation = body->GetOrient();
+		float angularVelocity = body->GetAngularVelocity();
+		mix(&position, sizeof(position));
+		mix(&velocity, sizeof(velocity));
+		mix(&rotation, sizeof(rotation));
+		mix(&angularVelocity, sizeof(angularVelocity));
+	}
+
+	uint64_t rngState = m_rng.GetState();
+	mix(&rngState, sizeof(rngState));
+	return hash;
+}
+
+Joint* PhysScene::AddJoint(Joint* joint)
+{
+	m_joints.push_back(joint);
+	return joint;
+}
+
+void PhysScene::RemoveJoint(Joint* joint)
+{
+	auto it = std::find(m_joints.begin(), m_joints.end(), joint);
+	if (it != m_joints.end())
+	{
+		delete joint;
+		m_joints.erase(it);
+	}
+}
+
+void PhysScene::UpdateLod()
+{
+	m_frozenCount = 0;
+	for (Rigidbody* body : m_rBodyList)
+	{
+		// Only bodies the step would move are worth freezing
+		if (body->IsKinematic() || (!body->IsFrozen() && body->GetMassData().iMass == 0.0f))
+			continue;
+
+		vec2 offset = abs(body->GetPosition() - m_lodFocus);
+		bool frozen = offset.x > m_lodExtents.x || offset.y > m_lodExtents.y;
+		body->SetFrozen(frozen);
+		m_frozenCount += frozen;
+	}
+}
+
+void PhysScene::BuildBroadphase()
+{
+	// Padded so pairs within speculative range of each other still share a tile
+	m_broadphase.Build(m_rBodyList.data(), (uint32_t)m_rBodyList.size(), Manifold::GetSpeculativeDistance() * 0.5f);
+	m_broadphaseValid = true;
+}
+
+void PhysScene::UpdateOrientations()
+{
+	size_t bodyCount = m_rBodyList.size();
+	uint32_t* turned = m_stepArena.allocateArray<uint32_t>(bodyCount);
+	float* angles = m_stepArena.allocateArray<float>(bodyCount);
+	float* sines = m_stepArena.allocateArray<float>(bodyCount);
+	float* cosines = m_stepArena.allocateArray<float>(bodyCount);
+
+	uint32_t count = 0;
+	for (size_t i = 0; i < bodyCount; ++i)
+	{
+		Rigidbody* body = m_rBodyList[i];
+		if (body->IsOrientStale())
+		{
+			turned[count] = (uint32_t)i;
+			angles[count++] = body->GetOrient();
+		}
+	}
+
+	hamh::SinCosBatch(angles, sines, cosines, count);
+	for (uint32_t i = 0; i < count; ++i)
+		m_rBodyList[turned[i]]->SetOrient(angles[i], sines[i], cosines[i]);
+}
+
+uint32_t PhysScene::GetColourIndex(Rigidbody* body)
+{
+	MassData md = body->GetMassData();
+	return (md.iMass == 0.0f && md.iInertia == 0.0f) ? BatchNoBody : body->GetSceneIndex();
+}
+
+void PhysScene::SortByBatch(const uint32_t* batches, uint32_t count, uint32_t batchCount, uint32_t* order, uint32_t* batchStart)
+{
+	memset(batchStart, 0, (batchCount + 1) * sizeof(uint32_t));
+	for (uint32_t i = 0; i < count; ++i)
+		++batchStart[batches[i] + 1];
+	for (uint32_t batch = 1; batch <= batchCount; ++batch)
+		batchStart[batch] += batchStart[batch - 1];
+	if (count == 0)
+		return;
+
+	// Scatter, keeping original order within each batch
+	uint32_t* cursor = m_stepArena.allocateArray<uint32_t>(batchCount);
+	memcpy(cursor, batchStart, batchCount * sizeof(uint32_t));
+	for (uint32_t i = 0; i < count; ++i)
+		order[cursor[batches[i]]++] = i;
+}
+
+void PhysScene::PrepareContacts()
+{
+	uint32_t contactCount = (uint32_t)m_contacts.size();
+
+	m_colouring.Begin(m_rBodyList.size(), m_stepArena);
+	uint32_t* batches = m_stepArena.allocateArray<uint32_t>(contactCount);
+	for (uint32_t i = 0; i < contactCount; ++i)
+		batches[i] = m_colouring.Assign(GetColourIndex(m_rBodyList[m_contacts[i].GetBodyA()]), GetColourIndex(m_rBodyList[m_contacts[i].GetBodyB()]));
+
+	m_contactBatchCount = m_colouring.GetBatchCount();
+	m_contactOrder = m_stepArena.allocateArray<uint32_t>(contactCount);
+	m_contactBatchStart = m_stepArena.allocateArray<uint32_t>(m_contactBatchCount + 1);
+	SortByBatch(batches, contactCount, m_contactBatchCount, m_contactOrder, m_contactBatchStart);
+}
+
+void PhysScene::SolveContacts(float invTimeStep)
+{
+	for (uint32_t batch = 0; batch < m_contactBatchCount; ++batch)
+	{
+		// OpenMP 2.0 requires signed loop indices
+		int first = (int)m_contactBatchStart[batch];
+		int last = (int)m_contactBatchStart[batch + 1];
+
+		// Contacts in a batch share no dynamic body, so can be solved concurrently without locks
+		// The overflow batch may share bodies & always runs serially
+#pragma omp parallel for if(!m_colouring.IsSerialBatch(batch) && last - first >= PS_PARALLELBATCH)
+		for (int i = first; i < last; ++i)
+			m_contacts[m_contactOrder[i]].ApplyImpulse(m_rBodyList.data(), invTimeStep);
+	}
+}
+
+void PhysScene::PrepareJoints()
+{
+	m_jointRows = JointRows();
+	if (m_joints.empty())
+		return;
+
+	uint32_t jointCount = (uint32_t)m_joints.size();
+	uint32_t rowCount = 0;
+
+	m_colouring.Begin(m_rBodyList.size(), m_stepArena);
+	uint32_t* batches = m_stepArena.allocateArray<uint32_t>(jointCount);
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		batches[i] = m_colouring.Assign(GetColourIndex(m_joints[i]->GetBodyA()), GetColourIndex(m_joints[i]->GetBodyB()));
+		rowCount += m_joints[i]->GetRowCount();
+	}
+
+	uint32_t batchCount = m_colouring.GetBatchCount();
+	m_jointRows.Allocate(m_stepArena, rowCount, jointCount, batchCount);
+
+	m_jointOrder = m_stepArena.allocateArray<uint32_t>(jointCount);
+	SortByBatch(batches, jointCount, batchCount, m_jointOrder, m_jointRows.batchStart);
+}
+
+void PhysScene::BuildJointRows(float timeStep)
+{
+	if (m_joints.empty())
+		return;
+
+	uint32_t jointCount = (uint32_t)m_joints.size();
+
+	// Emit rows in batch order, so each batch is one contiguous run of the SoA arrays
+	m_jointRows.rowCount = 0;
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		m_jointRows.jointRowStart[i] = m_jointRows.GetRowCount();
+		m_joints[m_jointOrder[i]]->BuildRows(m_jointRows, timeStep);
+	}
+	m_jointRows.jointRowStart[jointCount] = m_jointRows.GetRowCount();
+}
+
+void PhysScene::SolveJoints()
+{
+	// Joints within a batch share no dynamic body, so their order doesn't matter
+	for (uint32_t batch = 0; batch < m_jointRows.batchCount; ++batch)
+	{
+		int first = (int)m_jointRows.batchStart[batch];
+		int last = (int)m_jointRows.batchStart[batch + 1];
+
+#pragma omp parallel for if(!m_colouring.IsSerialBatch(batch) && last - first >= PS_PARALLELBATCH)
+		for (int joint = first; joint < last; ++joint)
+			m_jointRows.SolveJoint((uint32_t)joint);
 	}
 }
\ No newline at end of file
@@ -4,19 +4,38 @@
 
 // #define PS_DEBUG_MODE
 
+// Batches smaller than this are solved on the calling thread, as waking workers costs more
+const int PS_PARALLELBATCH = 64;
+// Side of the broadphase's tiles, around the size of a typical body's bounds
+const float PS_TILESIZE = 128.0f;
+
 // #include <glm/gtx/norm.hpp>
 
 #include <vector>
 #include <algorithm>
+#include <cstring>
+#include <cfloat>
 
 #include "Manifold.h"
+#include "Joint.h"
+#include "BatchColouring.h"
+#include "Random.h"
 #include "Sphere.h"
 #include "Polygon.h"
+#include "TileGrid.h"
+
+// Fixed part of a scene snapshot, followed by a BodyState per body
+struct SceneSnapshotHeader
+{
+	uint32_t bodyCount;
+	float accTime;
+	hamh::Rng rng;
+};
 
 class PhysScene
 {
 public:
-	PhysScene(float a_timeStep, vec2 a_gravity = vec2(0, 0));
+	PhysScene(float a_timeStep, vec2 a_gravity = vec2(0, 0), uint32_t a_seed = 0);
 	~PhysScene();
 
 	void Update(float deltaTime);
@@ -31,17 +50,145 @@ public:
 	// This class handles deletion of all contained bodies, do not delete manually!
 	Rigidbody* AddBody(Rigidbody* body);
 	void RemoveBody(Rigidbody* body);
+	// Removes a body without deleting it, ownership passes back to the caller
+	// Returns false if the body wasn't in the scene
+	bool DetachBody(Rigidbody* body);
 
 	// Get count of bodies in scene
 	size_t GetBodyCount() { return m_rBodyList.size(); }
 	// Get body from index
 	Rigidbody* GetBody(size_t index) { return m_rBodyList[index]; }
 
+	// Add joint between two bodies already in the scene
+	// Joints are deleted by the scene, including when either body is removed
+	Joint* AddJoint(Joint* joint);
+	void RemoveJoint(Joint* joint);
+
+	size_t GetJointCount() { return m_joints.size(); }
+
+	// Scene owned generator, so seeded runs replay the same randomness
+	hamh::Rng& GetRng() { return m_rng; }
+
+	// Writes bodies, RNG & time accumulator into a flat blob, reusing its storage
+	// Contacts are rebuilt from scratch each step, so nothing else needs saving
+	void Snapshot(std::vector<uint8_t>& blob);
+	// Rewinds to a snapshot taken with the same bodies in the scene, in place without allocating
+	// Returns false, leaving the scene untouched, if bodies were added or removed since
+	bool Restore(const std::vector<uint8_t>& blob);
+
+	// Hash of every body's state, for checking runs stay in lockstep across machines
+	uint64_t Checksum();
+
+	// Scratch memory released at the start of every step, for per-step arrays & event buffers
+	aie::LinearArena& GetStepArena() { return m_stepArena; }
+
+	// Velocity iterations shared by contacts & joints each step
+	void SetIterations(uint32_t iterations) { m_iterations = iterations; }
+
+	// Level of detail, bodies further than the extents from the focus on either axis are frozen
+	// Frozen bodies are static to everything else & resume with their old velocity once back in range
+	void SetLodFocus(const vec2& focus) { m_lodFocus = focus; }
+	void SetLodExtents(const vec2& halfExtents) { m_lodExtents = halfExtents; }
+	size_t GetFrozenCount() { return m_frozenCount; }
+
+	// Drawing only visits bodies within a view of this size from the renderer's camera, found via the broadphase
+	// Everything is drawn until a size is set
+	void SetViewSize(const vec2& size) { m_viewSize = size; }
+	// Calls func with the index of every body Draw would visit with the camera at cameraPos
+	template<typename Func>
+	void QueryView(const vec2& cameraPos, Func func);
+	// Bodies drawn & skipped by the last Draw
+	uint32_t GetDrawnCount() { return m_drawnCount; }
+	uint32_t GetCulledCount() { return m_culledCount; }
+
+	// Splits each step into sub-steps that integrate & solve against the step's contacts
+	// Collision detection still runs once per step, contact depths are carried between sub-steps
+	void SetSubSteps(uint32_t subSteps) { m_subSteps = subSteps > 0 ? subSteps : 1; }
+
 protected:
+	// Colouring index of a body, static bodies are never written so never conflict
+	static uint32_t GetColourIndex(Rigidbody* body);
+
+	// Counting sort of items by batch, filling order & the first item of each batch plus one past the end
+	void SortByBatch(const uint32_t* batches, uint32_t count, uint32_t batchCount, uint32_t* order, uint32_t* batchStart);
+
+	// Freezes & thaws dynamic bodies around the focus
+	void UpdateLod();
+
+	// Re-buckets every body at its current position
+	void BuildBroadphase();
+
+	// Rebuilds the rotation of every body that turned, working out all the sines & cosines in one batch
+	void UpdateOrientations();
+
+	// Colours contacts into batches that share no dynamic body
+	void PrepareContacts();
+	void SolveContacts(float invTimeStep);
+
+	// Colours joints into batches, rows are built separately as they depend on the sub-step
+	void PrepareJoints();
+	// Rebuilds every joint's rows in batch order from current positions
+	void BuildJointRows(float timeStep);
+	void SolveJoints();
+
 	float m_timeStep;
+	float m_accTime = 0.0f;
+	uint32_t m_iterations = 4;
+	uint32_t m_subSteps = 1;
 
 	vec2 m_gravity;
+
+	// Everything is simulated in full until extents are set
+	vec2 m_lodFocus = vec2(0, 0);
+	vec2 m_lodExtents = vec2(FLT_MAX, FLT_MAX);
+	size_t m_frozenCount = 0;
+
+	vec2 m_viewSize = vec2(FLT_MAX, FLT_MAX);
+	uint32_t m_drawnCount = 0;
+	uint32_t m_culledCount = 0;
+
+	hamh::Rng m_rng;
+
+	// Transient per-step arrays, released at the start of every step
+	aie::LinearArena m_stepArena;
 	
 	std::vector<Rigidbody*> m_rBodyList;
+
+	// Built at the end of each step & whenever bodies are added or removed, shared by the next step & drawing
+	// Bodies moved by hand between steps are only re-bucketed by the next step
+	TileGrid m_broadphase = TileGrid(PS_TILESIZE);
+	bool m_broadphaseValid = false;
+	std::vector<uint64_t> m_pairs;
+
 	std::vector<Manifold> m_contacts;
-};
\ No newline at end of file
+	// Contact indices in batch order, with the first of each batch plus one past the end
+	uint32_t* m_contactOrder = nullptr;
+	uint32_t* m_contactBatchStart = nullptr;
+	uint32_t m_contactBatchCount = 0;
+
+	std::vector<Joint*> m_joints;
+	// Joint indices in batch order
+	uint32_t* m_jointOrder = nullptr;
+	BatchColouring m_colouring;
+	JointRows m_jointRows;
+};
+
+template<typename Func>
+void PhysScene::QueryView(const vec2& cameraPos, Func func)
+{
+	// Without a view size nothing is culled, whichever side of the camera it's on
+	if (m_viewSize.x == FLT_MAX)
+	{
+		for (uint32_t i = 0; i < (uint32_t)m_rBodyList.size(); ++i)
+			func(i);
+		return;
+	}
+
+	if (!m_broadphaseValid)
+		BuildBroadphase();
+
+	AABB view;
+	view.min = cameraPos;
+	view.max = cameraPos + m_viewSize;
+	m_broadphase.Query(view, func);
+}
@@ -1,38 +1,63 @@
 #pragma once
 
-#include "Rigidbody.h"
+#include "PolygonShape.h"
 
-const uint32_t MaxPolyVertexCount = 20;
+// World vertices are processed in groups of this many by the SIMD kernels
+const uint32_t PolyVertexLanes = 4;
+
+static_assert(MaxPolyVertexCount % PolyVertexLanes == 0, "Vertex storage must pad to a whole number of lanes");
 
 class Polygon : public Rigidbody
 {
 public:
-	Polygon(float a_halfWidth, float a_halfHeight, vec2 a_position, Material a_mat, Colour a_col = Colour(1, 1, 1), vec2 a_initVelocity = vec2(), float a_rotation = 0.0f);
-	Polygon(vec2* a_vertices, uint32_t a_count, vec2 a_position, Material a_mat, Colour a_col = Colour(1, 1, 1), vec2 a_initVelocity = vec2(), float a_rotation = 0.0f);
+	Polygon(float a_halfWidth, float a_halfHeight, vec2 a_position, MaterialID a_mat, Colour a_col = Colour(1, 1, 1), vec2 a_initVelocity = vec2(), float a_rotation = 0.0f);
+	// Convex hull of any number of points, simplified to MaxPolyVertexCount corners if needed
+	Polygon(vec2* a_vertices, uint32_t a_count, vec2 a_position, MaterialID a_mat, Colour a_col = Colour(1, 1, 1), vec2 a_initVelocity = vec2(), float a_rotation = 0.0f);
+	// Shares existing shape data, taking a reference to it
+	Polygon(const PolygonShape* a_shape, vec2 a_position, MaterialID a_mat, Colour a_col = Colour(1, 1, 1), vec2 a_initVelocity = vec2(), float a_rotation = 0.0f);
+
+	// Copies share the shape, so keep its reference count in step
+	Polygon(const Polygon& other);
+	Polygon& operator=(const Polygon& other);
+	virtual ~Polygon();
 
 	virtual void Draw(aie::Renderer2D* renderer);
 
 	// The extreme point along a direction within a polygon
 	vec2 GetSupport(const vec2& dir);
-
-	uint32_t GetVertexCount() { return m_vertexCount; }
-	vec2 GetVertex(uint32_t index) { return m_vertices[index]; }
-	vec2 GetNormal(uint32_t index) { return m_normals[index]; }
+	// As above, using cached world-space vertices & a world-space direction
+	virtual vec2 GetWorldSupport(const vec2& dir);
+	// Smallest projection of any world-space vertex onto a direction, vectorised across vertices
+	float GetMinProjection(const vec2& dir);
+
+	const PolygonShape* GetPolygonShape() { return m_shape; }
+	uint32_t GetVertexCount() { return m_shape->vertexCount; }
+	vec2 GetVertex(uint32_t index) { return m_shape->vertices[index]; }
+	vec2 GetNormal(uint32_t index) { return m_shape->normals[index]; }
 	mat2 GetRotationMatrix() { return m_rotMatrix; }
 
-	void SetOrient(float radians) { hamh::SetRotation(m_rotMatrix, radians); }
+	// World-space data, valid as of the last UpdateWorldCache
+	vec2 GetWorldVertex(uint32_t index) { return vec2(m_worldX[index], m_worldY[index]); }
+	const vec2& GetWorldNormal(uint32_t index) { return m_worldNormals[index]; }
+
+	void UpdateWorldCache();
 
 private:
+	// Common setup once the shape is known
+	void Initialise(float density, float rotation);
 	virtual void ComputeMass(float density);
+	virtual void ApplyOrient(float sine, float cosine) { hamh::SetRotation(m_rotMatrix, sine, cosine); m_cacheDirty = true; }
 
-	// Exclusive variables for box rendering
-	bool m_isBox = false;
-	vec2 m_extents = vec2(0, 0);
-
-	uint32_t m_vertexCount;
-	vec2 m_vertices[MaxPolyVertexCount];
-	vec2 m_normals[MaxPolyVertexCount];
+	const PolygonShape* m_shape;
 
 	mat2 m_rotMatrix;
+
+	// Transformed vertices/normals shared by every pair test within a step
+	// Vertices are stored SoA & padded to a whole lane with copies of vertex 0
+	// Kept inline (320 of the polygon's 464 bytes) behind the hot Rigidbody fields, so integration never touches it
+	// & narrowphase reads it without a lookup; compound children & bodies outside a scene need one too
+	alignas(16) float m_worldX[MaxPolyVertexCount];
+	alignas(16) float m_worldY[MaxPolyVertexCount];
+	vec2 m_worldNormals[MaxPolyVertexCount];
 };
 
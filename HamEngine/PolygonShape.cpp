@@ -0,0 +1,285 @@
+#include "PolygonShape.h"
+
+#include <algorithm>
+#include <map>
+
+namespace
+{
+	// Interned boxes, each holding a reference of its own so it lives for the program
+	std::map<std::pair<float, float>, PolygonShape*> g_boxes;
+}
+
+const PolygonShape* PolygonShape::CreateBox(float a_halfWidth, float a_halfHeight)
+{
+	auto it = g_boxes.find(std::make_pair(a_halfWidth, a_halfHeight));
+	if (it != g_boxes.end())
+		return it->second;
+
+	PolygonShape* shape = new PolygonShape();
+	shape->vertexCount = 4;
+	shape->vertices[0] = vec2(-a_halfWidth, -a_halfHeight);
+	shape->vertices[1] = vec2(a_halfWidth, -a_halfHeight);
+	shape->vertices[2] = vec2(a_halfWidth, a_halfHeight);
+	shape->vertices[3] = vec2(-a_halfWidth, a_halfHeight);
+	shape->normals[0] = vec2(0, -1);
+	shape->normals[1] = vec2(1, 0);
+	shape->normals[2] = vec2(0, 1);
+	shape->normals[3] = vec2(-1, 0);
+	shape->ComputeProperties();
+
+	shape->AddRef();
+	g_boxes[std::make_pair(a_halfWidth, a_halfHeight)] = shape;
+	return shape;
+}
+
+const PolygonShape* PolygonShape::CreateHull(const vec2* a_vertices, uint32_t a_count, uint32_t a_maxVertices)
+{
+	// Reused between calls, so runtime hulls don't allocate once warmed up
+	static thread_local std::vector<vec2> s_points;
+	static thread_local std::vector<vec2> s_hull;
+
+	s_points.assign(a_vertices, a_vertices + a_count);
+	BuildHull(s_points, s_hull);
+
+	// >= 3 vertices required
+	assert(s_hull.size() > 2);
+
+	uint32_t budget = clamp(a_maxVertices, 3U, MaxPolyVertexCount);
+	if (s_hull.size() > budget)
+		SimplifyHull(s_hull, budget);
+
+	PolygonShape* shape = new PolygonShape();
+	shape->vertexCount = (uint32_t)s_hull.size();
+	for (uint32_t i = 0; i < shape->vertexCount; ++i)
+		shape->vertices[i] = s_hull[i];
+
+	// Compute face normals
+	for (uint32_t i1 = 0; i1 < shape->vertexCount; ++i1)
+	{
+		uint32_t i2 = i1 + 1 < shape->vertexCount ? i1 + 1 : 0;
+		vec2 face = shape->vertices[i2] - shape->vertices[i1];
+
+		// Ensure no zero-length edges, because that's bad
+		assert(length2(face) > hamh::sqr(epsilon<float>()));
+
+		// Calculate normal with 2d cross product between vector and scalar
+		shape->normals[i1] = normalize(vec2(face.y, -face.x));
+	}
+	shape->ComputeProperties();
+	return shape;
+}
+
+void PolygonShape::BuildHull(std::vector<vec2>& points, std::vector<vec2>& hull)
+{
+	// Akl-Toussaint, points inside the octagon of extremes can't be on the hull, so skip sorting them
+	if (points.size() > 16)
+	{
+		// Extremes along 8 directions, counter clockwise
+		const vec2 dirs[8] = { vec2(1, 0), vec2(1, 1), vec2(0, 1), vec2(-1, 1), vec2(-1, 0), vec2(-1, -1), vec2(0, -1), vec2(1, -1) };
+		vec2 extremes[8];
+		float best[8];
+		for (uint32_t d = 0; d < 8; ++d)
+		{
+			extremes[d] = points[0];
+			best[d] = dot(points[0], dirs[d]);
+		}
+		for (const vec2& p : points)
+		{
+			for (uint32_t d = 0; d < 8; ++d)
+			{
+				float projection = dot(p, dirs[d]);
+				if (projection > best[d])
+				{
+					best[d] = projection;
+					extremes[d] = p;
+				}
+			}
+		}
+
+		// A point can be extreme in several directions, keep one copy
+		vec2 octagon[8];
+		uint32_t corners = 0;
+		for (uint32_t d = 0; d < 8; ++d)
+			if (corners == 0 || extremes[d] != octagon[corners - 1])
+				octagon[corners++] = extremes[d];
+		if (corners > 1 && octagon[corners - 1] == octagon[0])
+			--corners;
+
+		if (corners >= 3)
+		{
+			auto inside = [&](const vec2& p)
+			{
+				for (uint32_t i = 0; i < corners; ++i)
+				{
+					const vec2& a = octagon[i];
+					const vec2& b = octagon[i + 1 < corners ? i + 1 : 0];
+					if (cross(b - a, p - a) <= 0.0f)
+						return false;
+				}
+				return true;
+			};
+			points.erase(std::remove_if(points.begin(), points.end(), inside), points.end());
+		}
+	}
+
+	// Andrew's monotone chain, O(n log n) from the sort
+	std::sort(points.begin(), points.end(), [](const vec2& a, const vec2& b)
+	{
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	});
+
+	hull.clear();
+	size_t count = points.size();
+	if (count < 3)
+	{
+		hull.assign(points.begin(), points.end());
+		return;
+	}
+	hull.reserve(count + 1);
+
+	// Lower chain left to right, then upper chain back, popping anything that isn't a left turn
+	// Collinear & duplicate points are dropped along the way
+	for (size_t i = 0; i < count; ++i)
+	{
+		while (hull.size() >= 2 && cross(hull[hull.size() - 1] - hull[hull.size() - 2], points[i] - hull[hull.size() - 2]) <= 0.0f)
+			hull.pop_back();
+		hull.push_back(points[i]);
+	}
+	size_t lowerSize = hull.size() + 1;
+	for (size_t i = count - 1; i-- > 0;)
+	{
+		while (hull.size() >= lowerSize && cross(hull[hull.size() - 1] - hull[hull.size() - 2], points[i] - hull[hull.size() - 2]) <= 0.0f)
+			hull.pop_back();
+		hull.push_back(points[i]);
+	}
+
+	// Last point repeats the first
+	hull.pop_back();
+}
+
+void PolygonShape::SimplifyHull(std::vector<vec2>& hull, uint32_t budget)
+{
+	// Visvalingam style, repeatedly drop the vertex whose triangle with its neighbours has the least area
+	// Removing a vertex from a convex polygon keeps it convex, so the result is still a valid hull
+	struct Entry
+	{
+		float area;
+		uint32_t vertex;
+		uint32_t stamp;
+		// Reversed, so the standard max heap functions pop the smallest area
+		bool operator<(const Entry& other) const { return area > other.area; }
+	};
+	static thread_local std::vector<uint32_t> s_links;
+	static thread_local std::vector<Entry> s_heap;
+
+	uint32_t count = (uint32_t)hull.size();
+	s_links.resize(count * 3);
+	uint32_t* prev = s_links.data();
+	uint32_t* next = prev + count;
+	// Bumped whenever a vertex's area changes, older heap entries for it are then stale
+	uint32_t* stamp = next + count;
+
+	const vec2* v = hull.data();
+	auto area = [&](uint32_t i)
+	{
+		return cross(v[i] - v[prev[i]], v[next[i]] - v[prev[i]]);
+	};
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		prev[i] = i == 0 ? count - 1 : i - 1;
+		next[i] = i + 1 == count ? 0 : i + 1;
+		stamp[i] = 0;
+	}
+
+	s_heap.clear();
+	for (uint32_t i = 0; i < count; ++i)
+		s_heap.push_back({ area(i), i, 0 });
+	std::make_heap(s_heap.begin(), s_heap.end());
+
+	uint32_t remaining = count;
+	uint32_t first = 0;
+	while (remaining > budget)
+	{
+		std::pop_heap(s_heap.begin(), s_heap.end());
+		Entry e = s_heap.back();
+		s_heap.pop_back();
+		if (e.stamp != stamp[e.vertex])
+			continue;
+
+		// Unlink, retiring the vertex & refreshing its neighbours
+		uint32_t p = prev[e.vertex], n = next[e.vertex];
+		next[p] = n;
+		prev[n] = p;
+		stamp[e.vertex] = UINT32_MAX;
+		if (e.vertex == first)
+			first = n;
+		--remaining;
+
+		s_heap.push_back({ area(p), p, ++stamp[p] });
+		std::push_heap(s_heap.begin(), s_heap.end());
+		s_heap.push_back({ area(n), n, ++stamp[n] });
+		std::push_heap(s_heap.begin(), s_heap.end());
+	}
+
+	// Compact the survivors, keeping their winding
+	static thread_local std::vector<vec2> s_kept;
+	s_kept.clear();
+	uint32_t i = first;
+	do
+	{
+		s_kept.push_back(hull[i]);
+		i = next[i];
+	} while (i != first);
+	hull.swap(s_kept);
+}
+
+void PolygonShape::Release() const
+{
+	if (--m_refCount == 0)
+		delete this;
+}
+
+void PolygonShape::ComputeProperties()
+{
+	// Calculate centroid and moment of inertia
+	vec2 c(0, 0); // centroid
+	float totalArea = 0.f;
+	float I = 0.f;
+	const float k_inv3 = 1.0f / 3.0f;
+
+	for (uint32_t i1 = 0; i1 < vertexCount; ++i1)
+	{
+		// triangle vertices, third vertex implied as 0, 0
+		vec2 p1(vertices[i1]);
+		uint32_t i2 = i1 + 1 < vertexCount ? i1 + 1 : 0;
+		vec2 p2(vertices[i2]);
+
+		float D = cross(p1, p2);
+		float triangleArea = 0.5f * D;
+
+		totalArea += triangleArea;
+
+		// use area to weight centroid average, not just vertex position
+		c += triangleArea * k_inv3 * (p1 + p2);
+
+		float intx2 = p1.x * p1.x + p2.x * p1.x + p2.x * p2.x;
+		float inty2 = p1.y * p1.y + p2.y * p1.y + p2.y * p2.y;
+		I += (0.25f * k_inv3 * D) * (intx2 + inty2);
+	}
+
+	c *= 1.0f / totalArea;
+
+	// translate vertices to centroid (make centroid 0, 0 for polygon space)
+	for (uint32_t i = 0; i < vertexCount; ++i)
+		vertices[i] -= c;
+
+	area = totalArea;
+	inertia = I;
+
+	// Vertices are relative to the centroid, so the farthest one bounds the polygon at any orientation
+	float radiusSqr = 0.f;
+	for (uint32_t i = 0; i < vertexCount; ++i)
+		radiusSqr = max(radiusSqr, length2(vertices[i]));
+	boundingRadius = sqrt(radiusSqr);
+}
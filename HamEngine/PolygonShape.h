@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Rigidbody.h"
+
+const uint32_t MaxPolyVertexCount = 20;
+
+// Immutable geometry & mass properties, shared by every polygon with the same shape
+// Reference counted, each polygon holds one reference for as long as it uses the shape
+class PolygonShape
+{
+public:
+	// Boxes are interned by size, so every box of the same extents shares one shape
+	static const PolygonShape* CreateBox(float a_halfWidth, float a_halfHeight);
+	// Convex hull of any number of points, recentred on its centroid
+	// Hulls with more than a_maxVertices corners are simplified down to it, capped at MaxPolyVertexCount
+	static const PolygonShape* CreateHull(const vec2* a_vertices, uint32_t a_count, uint32_t a_maxVertices = MaxPolyVertexCount);
+
+	void AddRef() const { ++m_refCount; }
+	// Deletes the shape once the last reference is released
+	void Release() const;
+
+	uint32_t vertexCount = 0;
+	vec2 vertices[MaxPolyVertexCount];		// Relative to the centroid
+	vec2 normals[MaxPolyVertexCount];
+
+	float boundingRadius = 0.f;
+
+	// Mass properties at unit density
+	float area = 0.f;
+	float inertia = 0.f;
+
+private:
+	PolygonShape() {}
+
+	// Counter clockwise hull of points, sorting them in place
+	static void BuildHull(std::vector<vec2>& points, std::vector<vec2>& hull);
+	// Drops the least significant corners until the hull fits the budget
+	static void SimplifyHull(std::vector<vec2>& hull, uint32_t budget);
+
+	// Centroid, area & inertia from the vertices, then moves the vertices onto the centroid
+	void ComputeProperties();
+
+	mutable uint32_t m_refCount = 0;
+};
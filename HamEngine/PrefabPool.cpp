@@ -0,0 +1,68 @@
+#include "PrefabPool.h"
+
+PrefabPool::~PrefabPool()
+{
+	for (Rigidbody* body : m_templates)
+		delete body;
+	for (Sphere* sphere : m_freeSpheres)
+		delete sphere;
+	for (Polygon* polygon : m_freePolygons)
+		delete polygon;
+}
+
+PrefabID PrefabPool::Register(Rigidbody* a_template)
+{
+	assert(a_template->GetShape() == ShapeType::ST_SPHERE || a_template->GetShape() == ShapeType::ST_POLYGON);
+
+	m_templates.push_back(a_template);
+	return (PrefabID)(m_templates.size() - 1);
+}
+
+Rigidbody* PrefabPool::Spawn(PrefabID prefab, const vec2& position, float rotation)
+{
+	Rigidbody* source = m_templates[prefab];
+	Rigidbody* body;
+
+	// Copying the template brings its geometry, mass & material along, only the transform differs
+	if (source->GetShape() == ShapeType::ST_SPHERE)
+	{
+		Sphere* sphere;
+		if (m_freeSpheres.empty())
+			sphere = new Sphere(*static_cast<Sphere*>(source));
+		else
+		{
+			sphere = m_freeSpheres.back();
+			m_freeSpheres.pop_back();
+			*sphere = *static_cast<Sphere*>(source);
+		}
+		body = sphere;
+	}
+	else
+	{
+		Polygon* polygon;
+		if (m_freePolygons.empty())
+			polygon = new Polygon(*static_cast<Polygon*>(source));
+		else
+		{
+			polygon = m_freePolygons.back();
+			m_freePolygons.pop_back();
+			*polygon = *static_cast<Polygon*>(source);
+		}
+		body = polygon;
+	}
+
+	// Set through the state so rotation is recorded as well as applied
+	BodyState state = body->GetState();
+	state.position = position;
+	state.rotation = rotation;
+	body->SetState(state);
+	return body;
+}
+
+void PrefabPool::Release(Rigidbody* body)
+{
+	if (body->GetShape() == ShapeType::ST_SPHERE)
+		m_freeSpheres.push_back(static_cast<Sphere*>(body));
+	else
+		m_freePolygons.push_back(static_cast<Polygon*>(body));
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include "Sphere.h"
+#include "Polygon.h"
+
+typedef uint32_t PrefabID;
+
+// Template bodies with their shape & mass data worked out once, stamped into recycled instances
+// Spawning copies the template over a released instance, so costs no hull or mass work & no allocation
+// Only spheres & polygons can be prefabs
+class PrefabPool
+{
+public:
+	~PrefabPool();
+
+	// Takes ownership of a body to use as the template, it never enters a scene itself
+	PrefabID Register(Rigidbody* a_template);
+
+	// Instance of the prefab at a transform, ready to add to a scene
+	Rigidbody* Spawn(PrefabID prefab, const vec2& position, float rotation);
+	// Returns a body spawned by this pool once it has been detached from its scene
+	void Release(Rigidbody* body);
+
+	size_t GetPrefabCount() { return m_templates.size(); }
+	size_t GetFreeCount() { return m_freeSpheres.size() + m_freePolygons.size(); }
+
+private:
+	std::vector<Rigidbody*> m_templates;
+
+	// Released instances, a template only overwrites instances of its own shape
+	std::vector<Sphere*> m_freeSpheres;
+	std::vector<Polygon*> m_freePolygons;
+};
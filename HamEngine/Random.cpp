@@ -0,0 +1,97 @@
+#include "Random.h"
+
+#include <atomic>
+
+namespace hamh
+{
+	Rng& ThreadRng()
+	{
+		// Every thread gets its own stream, so threads never share or contend on state
+		static std::atomic<uint64_t> s_nextStream(0);
+		static thread_local Rng rng(0, s_nextStream++);
+		return rng;
+	}
+
+	void SeedThreadRng(uint64_t seed)
+	{
+		Rng& rng = ThreadRng();
+		rng.Seed(seed, rng.GetStream());
+	}
+
+	RngBatch::RngBatch(Rng& seeder)
+	{
+		for (uint32_t lane = 0; lane < 4; ++lane)
+		{
+			// Xoshiro can't recover from an all zero state
+			do
+			{
+				for (uint32_t word = 0; word < 4; ++word)
+					m_state[word][lane] = seeder.Next();
+			} while ((m_state[0][lane] | m_state[1][lane] | m_state[2][lane] | m_state[3][lane]) == 0);
+		}
+	}
+
+	void RngBatch::Fill(float* out, size_t count)
+	{
+		FillRange(out, count, 0.0f, 1.0f);
+	}
+
+	void RngBatch::FillRange(float* out, size_t count, float lower, float higher)
+	{
+		const float scale = (higher - lower) / 16777216.0f;
+		size_t i = 0;
+
+#ifdef HAMH_SSE
+		__m128i s0 = _mm_load_si128((const __m128i*)m_state[0]);
+		__m128i s1 = _mm_load_si128((const __m128i*)m_state[1]);
+		__m128i s2 = _mm_load_si128((const __m128i*)m_state[2]);
+		__m128i s3 = _mm_load_si128((const __m128i*)m_state[3]);
+		__m128 vScale = _mm_set1_ps(scale);
+		__m128 vLower = _mm_set1_ps(lower);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i result = _mm_add_epi32(s0, s3);
+
+			__m128i t = _mm_slli_epi32(s1, 9);
+			s2 = _mm_xor_si128(s2, s0);
+			s3 = _mm_xor_si128(s3, s1);
+			s1 = _mm_xor_si128(s1, s2);
+			s0 = _mm_xor_si128(s0, s3);
+			s2 = _mm_xor_si128(s2, t);
+			s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+			// Top 24 bits fit a signed int exactly, so the signed convert is safe
+			__m128 f = _mm_cvtepi32_ps(_mm_srli_epi32(result, 8));
+			_mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(f, vScale), vLower));
+		}
+
+		_mm_store_si128((__m128i*)m_state[0], s0);
+		_mm_store_si128((__m128i*)m_state[1], s1);
+		_mm_store_si128((__m128i*)m_state[2], s2);
+		_mm_store_si128((__m128i*)m_state[3], s3);
+#endif
+
+		// Remainder, or everything without SSE, lane by lane in the same order
+		for (; i < count; ++i)
+		{
+			uint32_t lane = i & 3;
+			uint32_t& w0 = m_state[0][lane];
+			uint32_t& w1 = m_state[1][lane];
+			uint32_t& w2 = m_state[2][lane];
+			uint32_t& w3 = m_state[3][lane];
+
+			uint32_t result = w0 + w3;
+
+			uint32_t t = w1 << 9;
+			w2 ^= w0;
+			w3 ^= w1;
+			w1 ^= w2;
+			w0 ^= w3;
+			w2 ^= t;
+			w3 = (w3 << 11) | (w3 >> 21);
+
+			out[i] = (float)(result >> 8) * scale + lower;
+		}
+	}
+}
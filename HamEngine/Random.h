@@ -0,0 +1,113 @@
+#pragma once
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Helpers.h"
+
+namespace hamh
+{
+	// PCG32 generator, small & fully specified so a seed gives the same sequence on every machine
+	// Each stream is an independent sequence for the same seed
+	class Rng
+	{
+	public:
+		Rng(uint64_t seed = 0, uint64_t stream = 0) { Seed(seed, stream); }
+
+		void Seed(uint64_t seed, uint64_t stream = 0)
+		{
+			m_state = 0;
+			m_inc = (stream << 1) | 1;
+			Next();
+			m_state += seed;
+			Next();
+		}
+
+		uint32_t Next()
+		{
+			uint64_t old = m_state;
+			m_state = old * 6364136223846793005ULL + m_inc;
+			uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+			uint32_t rot = (uint32_t)(old >> 59);
+			return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+		}
+
+		// New generator on its own stream, for handing to an emitter, world or thread
+		Rng Fork(uint64_t stream)
+		{
+			uint64_t seed = ((uint64_t)Next() << 32) | Next();
+			return Rng(seed, stream);
+		}
+
+		// Return float in the range of 0..1
+		float fRand() { return (float)(Next() >> 8) / 16777216.0f; }
+
+		float fRandRange(float lower, float higher) { return lower + fRand() * (higher - lower); }
+
+		// Integer in [lower, higher), without the bias of a plain modulo
+		int RandRange(int lower, int higher)
+		{
+			uint32_t range = (uint32_t)(higher - lower);
+			uint64_t m = (uint64_t)Next() * range;
+			uint32_t low = (uint32_t)m;
+			// Reject the few values that would favour the start of the range
+			if (low < range)
+			{
+				uint32_t threshold = (0u - range) % range;
+				while (low < threshold)
+				{
+					m = (uint64_t)Next() * range;
+					low = (uint32_t)m;
+				}
+			}
+			return lower + (int)(m >> 32);
+		}
+
+		uint64_t GetState() { return m_state; }
+		uint64_t GetStream() { return m_inc >> 1; }
+
+	private:
+		uint64_t m_state;
+		uint64_t m_inc;
+	};
+
+	// Four xoshiro128+ generators advanced in lockstep, for filling large batches of floats
+	// Each lane is a SIMD lane when SSE2 is available
+	class RngBatch
+	{
+	public:
+		// Seeds every lane from an existing generator, so batches inherit its stream
+		RngBatch(Rng& seeder);
+
+		// Floats in the range of 0..1
+		void Fill(float* out, size_t count);
+		void FillRange(float* out, size_t count, float lower, float higher);
+
+	private:
+		// State word major, so each word loads as one vector of 4 lanes
+		alignas(16) uint32_t m_state[4][4];
+	};
+
+	// Generator for code without a scene or emitter of its own, one per thread
+	Rng& ThreadRng();
+	// Reseeds the calling thread's generator, keeping it on its own stream
+	void SeedThreadRng(uint64_t seed);
+
+	// Return float in the range of 0..1
+	inline float fRand()
+	{
+		return ThreadRng().fRand();
+	}
+
+	inline float fRandRange(float lower, float higher)
+	{
+		return ThreadRng().fRandRange(lower, higher);
+	}
+
+	inline int RandRange(int lower, int higher)
+	{
+		return ThreadRng().RandRange(lower, higher);
+	}
+}
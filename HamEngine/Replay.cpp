@@ -0,0 +1,137 @@
+#include "Replay.h"
+
+#include <chrono>
+#include <cstdio>
+
+template <typename T>
+static void Write(std::ofstream& stream, const T& value)
+{
+	stream.write((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static bool Read(std::ifstream& stream, T& value)
+{
+	return (bool)stream.read((char*)&value, sizeof(T));
+}
+
+bool ReplayRecorder::Open(const char* path, uint32_t seed)
+{
+	m_stream.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_stream)
+		return false;
+
+	Write(m_stream, RPL_MAGIC);
+	Write(m_stream, RPL_VERSION);
+	Write(m_stream, seed);
+	return true;
+}
+
+void ReplayRecorder::Record(const ClimberInput& input)
+{
+	if (!m_stream.is_open())
+		return;
+
+	uint8_t flags = input.placeBarrier ? RF_BARRIER : RF_NONE;
+	Write(m_stream, input.deltaTime);
+	Write(m_stream, flags);
+	if (flags & RF_BARRIER)
+	{
+		Write(m_stream, input.barrierCount);
+		m_stream.write((const char*)input.barrierStroke, sizeof(vec2) * input.barrierCount);
+	}
+}
+
+bool ReplayPlayer::Open(const char* path)
+{
+	m_stream.open(path, std::ios::binary);
+
+	uint32_t magic;
+	if (!Read(m_stream, magic) || !Read(m_stream, m_version) || !Read(m_stream, m_seed))
+		return false;
+	return magic == RPL_MAGIC && m_version >= RPL_MINVERSION && m_version <= RPL_VERSION;
+}
+
+bool ReplayPlayer::Next(ClimberInput& input)
+{
+	uint8_t flags;
+	if (!Read(m_stream, input.deltaTime) || !Read(m_stream, flags))
+		return false;
+
+	input.placeBarrier = (flags & RF_BARRIER) != 0;
+	input.barrierStroke = nullptr;
+	input.barrierCount = 0;
+	if (!input.placeBarrier)
+		return true;
+
+	uint32_t count = 2;
+	if (m_version > 1 && !Read(m_stream, count))
+		return false;
+	// Recorded strokes hold at least the click that started them & never exceed the barrier's limit
+	if (count == 0 || count > BAR_MAXPOINTS)
+	{
+		m_corrupt = true;
+		return false;
+	}
+	m_stroke.resize(count);
+	if (!m_stream.read((char*)m_stroke.data(), sizeof(vec2) * count))
+		return false;
+
+	input.barrierStroke = m_stroke.data();
+	input.barrierCount = count;
+	return true;
+}
+
+int RunReplay(const char* path)
+{
+	ReplayPlayer player;
+	if (!player.Open(path))
+	{
+		printf("Couldn't read replay %s\n", path);
+		return 1;
+	}
+
+	SkyClimber game(player.GetSeed());
+
+	uint32_t frames = 0;
+	float simTime = 0.0f;
+	ClimberInput input;
+
+#ifdef DEBUG_ALLOCCOUNT
+	size_t totalAllocs = 0;
+	uint32_t allocFrames = 0;
+#endif // Allocation counting
+
+	auto start = std::chrono::high_resolution_clock::now();
+	while (player.Next(input))
+	{
+#ifdef DEBUG_ALLOCCOUNT
+		size_t allocsBefore = g_allocCount;
+#endif // Allocation counting
+
+		game.Update(input);
+		simTime += input.deltaTime;
+		++frames;
+
+#ifdef DEBUG_ALLOCCOUNT
+		size_t allocs = g_allocCount - allocsBefore;
+		totalAllocs += allocs;
+		allocFrames += allocs ? 1 : 0;
+#endif // Allocation counting
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	if (player.IsCorrupt())
+	{
+		printf("Replay %s is corrupt after %u frames\n", path, frames);
+		return 1;
+	}
+
+	double ms = std::chrono::duration<double, std::milli>(end - start).count();
+	printf("Replayed %u frames (%.1fs of play) in %.1fms, %.3fms per frame\n", frames, simTime, ms, frames ? ms / frames : 0.0);
+#ifdef DEBUG_ALLOCCOUNT
+	printf("%u of %u frames allocated, %zu allocations, step arena peak %zu bytes\n", allocFrames, frames, totalAllocs, game.GetScene()->GetStepArena().getHighWater());
+#endif // Allocation counting
+	printf("Seed %u, height %.f, checksum %016llx\n", player.GetSeed(), game.GetCamHeight(), (unsigned long long)game.GetScene()->Checksum());
+	return 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <fstream>
+
+#include "SkyClimber.h"
+
+// Identifies a replay stream & its layout version
+constexpr static uint32_t RPL_MAGIC = 0x4C505248;	// "HRPL"
+constexpr static uint32_t RPL_VERSION = 2;
+// Oldest layout still readable, version 1 barriers were a start & end only
+constexpr static uint32_t RPL_MINVERSION = 1;
+
+// Session recorded by the game, overwritten every run
+constexpr static const char* RPL_DEFAULTPATH = "./last.replay";
+
+// Layout: magic, version, seed, then per frame a delta time & flags byte
+// Frames that commit a barrier follow the flags with its point count & points
+enum ReplayFlags : uint8_t
+{
+	RF_NONE = 0,
+	RF_BARRIER = 1 << 0
+};
+
+// Logs every simulated frame's input so a session can be re-run exactly
+class ReplayRecorder
+{
+public:
+	bool Open(const char* path, uint32_t seed);
+	void Record(const ClimberInput& input);
+	void Close() { m_stream.close(); }
+
+private:
+	std::ofstream m_stream;
+};
+
+// Reads back a recorded session
+class ReplayPlayer
+{
+public:
+	bool Open(const char* path);
+	// Fetches the next frame, false once the stream ends or a frame can't be trusted
+	bool Next(ClimberInput& input);
+
+	uint32_t GetSeed() { return m_seed; }
+	// True if playback stopped at a malformed frame rather than the end of the file
+	bool IsCorrupt() { return m_corrupt; }
+
+private:
+	std::ifstream m_stream;
+	uint32_t m_seed = 0;
+	uint32_t m_version = 0;
+	bool m_corrupt = false;
+
+	// Backs the current frame's barrier stroke
+	std::vector<vec2> m_stroke;
+};
+
+// Re-runs a replay through the simulation as fast as possible & reports timings
+// Needs no window, so sessions can be profiled offline
+int RunReplay(const char* path);
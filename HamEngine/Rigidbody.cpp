@@ -1,10 +1,10 @@
 #include "Rigidbody.h"
 
-Rigidbody::Rigidbody(ShapeType a_type, vec2 a_initPosition, vec2 a_initVelocity, Material a_mat, Colour a_col)
+Rigidbody::Rigidbody(ShapeType a_type, vec2 a_initPosition, vec2 a_initVelocity, MaterialID a_mat, Colour a_col)
 {
 	m_position = a_initPosition;
 	// Check for static object & nullify velocity if true
-	m_velocity = (a_mat.density) ? a_initVelocity : vec2(0, 0);
+	m_velocity = (materials::Get(a_mat).density) ? a_initVelocity : vec2(0, 0);
 	m_sType = a_type;
 	m_material = a_mat;
 	m_colour = a_col;
@@ -21,19 +21,104 @@ void Rigidbody::IntegrateForces(const vec2& gravity, float timeStep)
 
 void Rigidbody::IntegrateVelocity(const vec2& gravity, float timeStep)
 {
+	// Kinematic bodies follow their scripted velocity, unaffected by forces
+	if (m_isKinematic)
+	{
+		m_position += m_velocity * timeStep;
+		m_rotation += m_angularVelocity * timeStep;
+		m_cacheDirty = true;
+		return;
+	}
+
 	if (m_massData.iMass == 0.0f)
 		return;
 
 	m_position += m_velocity * timeStep;
 	m_rotation += m_angularVelocity * timeStep;
-	// For shapes that care about orientation, this function is overloaded
-	// Otherwise does nothing
-	SetOrient(m_rotation);
+	m_cacheDirty = true;
 	IntegrateForces(gravity, timeStep);
 }
 
+void Rigidbody::SetOrient(float radians)
+{
+	float s, c;
+	hamh::FastSinCos(radians, s, c);
+	SetOrient(radians, s, c);
+}
+
 void Rigidbody::ApplyImpulse(const vec2& impulse, const vec2& contact)
 {
+	// Never write to static bodies, they may be shared by constraints solved in parallel
+	if (m_massData.iMass == 0.0f && m_massData.iInertia == 0.0f)
+		return;
+
 	m_velocity += m_massData.iMass * impulse;
 	m_angularVelocity += m_massData.iInertia * cross(contact, impulse);
 }
+
+void Rigidbody::ApplyImpulse(const vec2& impulse, float angularImpulse)
+{
+	if (m_massData.iMass == 0.0f && m_massData.iInertia == 0.0f)
+		return;
+
+	m_velocity += m_massData.iMass * impulse;
+	m_angularVelocity += m_massData.iInertia * angularImpulse;
+}
+
+void Rigidbody::SetFrozen(bool frozen)
+{
+	if (frozen == m_isFrozen)
+		return;
+
+	if (frozen)
+	{
+		// Zero mass makes every part of the step treat the body as static
+		m_frozenMass = m_massData;
+		m_frozenVelocity = m_velocity;
+		m_frozenAngularVelocity = m_angularVelocity;
+		m_massData = MassData();
+		m_velocity = vec2(0, 0);
+		m_angularVelocity = 0.0f;
+	}
+	else
+	{
+		m_massData = m_frozenMass;
+		m_velocity = m_frozenVelocity;
+		m_angularVelocity = m_frozenAngularVelocity;
+	}
+	m_isFrozen = frozen;
+}
+
+BodyState Rigidbody::GetState()
+{
+	BodyState state;
+	state.position = m_position;
+	// Frozen bodies report the velocity they'll resume with
+	state.velocity = m_isFrozen ? m_frozenVelocity : m_velocity;
+	state.force = m_force;
+	state.rotation = m_rotation;
+	state.angularVelocity = m_isFrozen ? m_frozenAngularVelocity : m_angularVelocity;
+	state.torque = m_torque;
+	return state;
+}
+
+void Rigidbody::SetState(const BodyState& state)
+{
+	// Go through the setters so shapes can mark cached data dirty
+	SetPosition(state.position);
+	if (m_isFrozen)
+	{
+		m_frozenVelocity = state.velocity;
+		m_frozenAngularVelocity = state.angularVelocity;
+	}
+	else
+	{
+		m_velocity = state.velocity;
+		m_angularVelocity = state.angularVelocity;
+	}
+	m_force = state.force;
+	m_rotation = state.rotation;
+	m_torque = state.torque;
+	SetOrient(m_rotation);
+	UpdateWorldCache();
+}
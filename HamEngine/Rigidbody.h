@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "Colour.h"
+#include "Material.h"
 #include "Helpers.h"
 
 using namespace glm;
@@ -25,20 +26,12 @@ enum class ShapeType : uint16_t
 	ST_SPHERE,
 	ST_POLYGON,
 	ST_LINE,
+	ST_CAPSULE,
+	ST_COMPOUND,
 
 	ST_SHAPE_COUNT
 };
 
-// Material for physics responses. Default is metal.
-struct Material
-{
-	Material() {}
-	Material(float d, float r) { density = d; restitution = r; }
-
-	float density = 1.2f;
-	float restitution = 0.05f;
-};
-
 // Stores only inverse of mass/inertia as those values are most commonly used
 struct MassData
 {
@@ -57,10 +50,29 @@ struct MassData
 	float iInertia;
 };
 
+// Axis-aligned bounding box in world space
+struct AABB
+{
+	vec2 min = vec2(0, 0);
+	vec2 max = vec2(0, 0);
+};
+
+// Everything about a body that changes during simulation, flat so it can be copied as raw bytes
+struct BodyState
+{
+	vec2 position;
+	vec2 velocity;
+	vec2 force;
+	float rotation;
+	float angularVelocity;
+	float torque;
+};
+
 class Rigidbody
 {
 public:
-	Rigidbody(ShapeType a_type, vec2 a_initPosition, vec2 a_initVelocity, Material a_mat, Colour a_col);
+	Rigidbody(ShapeType a_type, vec2 a_initPosition, vec2 a_initVelocity, MaterialID a_mat, Colour a_col);
+	virtual ~Rigidbody() {}
 
 	virtual void Draw(aie::Renderer2D* renderer) = 0;
 
@@ -68,8 +80,10 @@ public:
 	void IntegrateVelocity(const vec2& gravity, float timeStep);
 
 	ShapeType GetShape() { return m_sType; }
-	Material GetMaterial() { return m_material; }
+	MaterialID GetMaterial() { return m_material; }
 	MassData GetMassData() { return m_massData; }
+	// Radius around position that fully contains the shape
+	float GetBoundingRadius() { return m_boundingRadius; }
 	Colour GetColour() { return m_colour; }
 
 	vec2 GetPosition() { return m_position; }
@@ -77,35 +91,84 @@ public:
 	float GetOrient() { return m_rotation; }
 	float GetAngularVelocity() { return m_angularVelocity; }
 	
-	float GetStaticFriction() { return m_staticFriction; }
-	float GetDynamicFriction() { return m_dynamicFriction; }
+	// Kinematic bodies have infinite mass but are moved by their velocity during integration
+	bool IsKinematic() { return m_isKinematic; }
+	void SetKinematic(bool kinematic) { m_isKinematic = kinematic; }
+
+	// Frozen bodies act as static until thawed, keeping their mass & velocity aside
+	// Used by the scene's level of detail, static & kinematic bodies are never frozen
+	bool IsFrozen() { return m_isFrozen; }
+	void SetFrozen(bool frozen);
 
 	void ApplyImpulse(const vec2& impulse, const vec2& contact);
+	// Impulse with its angular component already resolved, used by constraint rows
+	void ApplyImpulse(const vec2& impulse, float angularImpulse);
 	void ResetForce() { m_force = vec2(0, 0); m_torque = 0.0f; }
 
-	virtual void SetPosition(const vec2& position) { m_position = position; }
-	virtual void AddPosition(const vec2& translation) { m_position += translation; }
+	virtual void SetPosition(const vec2& position) { m_position = position; m_cacheDirty = true; }
+	virtual void AddPosition(const vec2& translation) { m_position += translation; m_cacheDirty = true; }
 	virtual void SetVelocity(const vec2& velocity) { m_velocity = velocity; }
 	virtual void AddVelocity(const vec2& velocity) { m_velocity += velocity; }
+	// Called after each step the body was pushed by a contact, speculative or touching
+	virtual void OnImpact() {}
 	
-	virtual void SetOrient(float radians) = 0;
+	// Rebuilds the shape's rotation for an angle, m_rotation itself is left alone
+	void SetOrient(float radians);
+	// Same with the angle's sine & cosine already worked out, so the scene can batch the trig
+	void SetOrient(float radians, float sine, float cosine) { m_orientation = radians; ApplyOrient(sine, cosine); }
+	// Sets the body's angle & rebuilds its shape rotation to match, for bodies placed by hand
+	void SetRotation(float radians) { m_rotation = radians; SetOrient(radians); }
+	// Integration only advances m_rotation, the scene rebuilds stale shape rotations once per step
+	bool IsOrientStale() { return m_hasOrient && m_orientation != m_rotation; }
+
+	// Extreme point of the shape's core along a world-space direction
+	// Rounded shapes return their inner core & report the rounding through GetSupportRadius
+	virtual vec2 GetWorldSupport(const vec2& dir) = 0;
+	virtual float GetSupportRadius() { return 0.f; }
+
+	// Capture & reapply simulated state, shape & mass data are left alone
+	BodyState GetState();
+	void SetState(const BodyState& state);
+
+	// Position in the owning scene's body list, kept up to date by the scene
+	uint32_t GetSceneIndex() { return m_sceneIndex; }
+	void SetSceneIndex(uint32_t index) { m_sceneIndex = index; }
+
+	// Refresh any world-space data cached by the shape, called by the scene once per step after integration
+	virtual void UpdateWorldCache() {}
 	
 protected:
 	virtual void ComputeMass(float density) {};
+	// Shapes that depend on orientation rebuild their rotation here
+	virtual void ApplyOrient(float /*sine*/, float /*cosine*/) {}
 
 	ShapeType m_sType;
-	Material m_material;
+	MaterialID m_material;
 	MassData m_massData;
 	Colour m_colour;
 
+	bool m_isKinematic = false;
+	bool m_isFrozen = false;
+	// Set whenever the transform changes, shapes caching world-space data refresh it in UpdateWorldCache
+	bool m_cacheDirty = true;
+	// Cleared by shapes that look the same at any angle, their rotation is never rebuilt
+	bool m_hasOrient = true;
+
+	float m_boundingRadius = 0.f;
+
+	uint32_t m_sceneIndex = 0;
+
 	vec2 m_position = vec2(0, 0);
 	vec2 m_velocity = vec2(0, 0);
 	float m_rotation = 0.f; // radians
+	float m_orientation = 0.f; // radians the shape's rotation was last built for
 	float m_angularVelocity = 0.f;
 
 	vec2 m_force = vec2(0, 0);
 	float m_torque = 0.0f;
 
-	float m_staticFriction = 0.4f;
-	float m_dynamicFriction = 0.2f;
+	// Real mass & velocity while frozen
+	MassData m_frozenMass;
+	vec2 m_frozenVelocity = vec2(0, 0);
+	float m_frozenAngularVelocity = 0.0f;
 };
\ No newline at end of file
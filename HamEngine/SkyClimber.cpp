@@ -0,0 +1,103 @@
+#include "SkyClimber.h"
+
+SkyClimber::SkyClimber(uint32_t a_seed)
+{
+	m_physScene = new PhysScene(SIM_TIMESTEP, vec2(0, -100), a_seed);
+	m_world = new ChunkWorld(m_physScene, a_seed, CHK_HEIGHT, WINDOW_WIDTH);
+
+	const float wallDepth = 100;
+	const float wallHeight = WINDOW_HEIGHT;
+	const MaterialID wallMat = materials::Register(Material(0.f, 0.8f));
+	const Colour wallCol(1, 1, 0);
+
+	// Outer walls
+	m_wallRight = static_cast<Polygon*>(m_physScene->AddBody(new Polygon(wallDepth, wallHeight, vec2(WINDOW_WIDTH + wallDepth - 1, wallHeight / 2.f), wallMat, wallCol, vec2(), 0.0f)));
+	m_wallLeft = static_cast<Polygon*>(m_physScene->AddBody(new Polygon(wallDepth, wallHeight, vec2(-wallDepth + 1, wallHeight / 2.f), wallMat, wallCol, vec2(), 0.0f)));
+	// Walls scroll with the camera, so let the integrator move them
+	m_wallRight->SetKinematic(true);
+	m_wallLeft->SetKinematic(true);
+
+	// Bug where falling perfectly downwards causes some math messiness, todo: fix that
+	m_ball = static_cast<Sphere*>(m_physScene->AddBody(new Sphere(20, vec2(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2), materials::Register(Material(1.2f, 0.7f)), Colour(1, 0, 0, 1)/*, vec2(0.01f, 0)*/)));
+
+	// Starter platform, erased after player makes their own
+	vec2 starter[2] = { m_ball->GetPosition() + vec2(-100, -25), m_ball->GetPosition() + vec2(100, -25) };
+	m_barrier = static_cast<Barrier*>(m_physScene->AddBody(new Barrier(starter, 2, materials::Register(Material(0.f, 0.0f)), Colour(1, 0, 0))));
+
+	m_barrierMat = materials::Register(Material(0.f, 4.0f));
+
+	// Only bodies near the screen are worth simulating, matching the range chunks are kept loaded
+	m_physScene->SetLodExtents(vec2(FLT_MAX, WINDOW_HH + CHK_LOADDISTANCE));
+	// Chunks are loaded ahead of the camera, only what's on screen needs drawing
+	m_physScene->SetViewSize(vec2(WINDOW_WIDTH, WINDOW_HEIGHT));
+}
+
+SkyClimber::~SkyClimber()
+{
+	delete m_world;
+	delete m_physScene;
+}
+
+void SkyClimber::Update(const ClimberInput& input)
+{
+	if (m_gameOver)
+		return;
+
+	m_physScene->SetLodFocus(vec2(WINDOW_WH, m_camHeight + WINDOW_HH));
+	m_physScene->Update(input.deltaTime);
+
+	vec2 ballPos = m_ball->GetPosition();
+	// Convert world space to camera space
+	vec2 conv = ballPos - vec2(WINDOW_WH, WINDOW_HH);
+
+	float ballPosUpperDifference = conv.y - m_camUpperBound;
+
+	// Alter camera bounds as the ball rises
+	if (ballPosUpperDifference > 0.0f)
+	{
+		m_camUpperBound += ballPosUpperDifference;
+		m_camLowerBound += ballPosUpperDifference;
+		m_camLowerDestroyBound += ballPosUpperDifference;
+		m_camHeight += ballPosUpperDifference;
+	}
+
+	// Drive walls towards the camera, so they arrive over the next frame's steps
+	if (input.deltaTime > 0.0f)
+	{
+		vec2 wallVelocity = vec2(0, (m_camHeight + WINDOW_HH - m_wallLeft->GetPosition().y) / input.deltaTime);
+		m_wallLeft->SetVelocity(wallVelocity);
+		m_wallRight->SetVelocity(wallVelocity);
+	}
+
+	if (input.placeBarrier && input.barrierCount > 0)
+	{
+		// Remove old barrier from simulation
+		m_physScene->RemoveBody(m_barrier);
+		// Add this as the new barrier
+		m_barrier = static_cast<Barrier*>(m_physScene->AddBody(new Barrier(input.barrierStroke, input.barrierCount, m_barrierMat, Colour(0, 1, 0))));
+		m_gameStart = true;
+	}
+
+	if (m_barrier && m_barrier->hit && m_gameStart)
+	{
+		m_physScene->RemoveBody(m_barrier);
+		m_barrier = nullptr;
+	}
+
+	// Stream obstacle chunks around the camera
+	m_world->Update(m_camHeight, WINDOW_HEIGHT);
+
+	// Ball failure condition check
+	if (m_ball->GetPosition().y < m_camHeight - OBS_AVGSPAWNSPACING)
+	{
+		m_gameOver = true;
+		// remove and nullptr the ball
+		m_physScene->RemoveBody(m_ball);
+		m_ball = nullptr;
+	}
+}
+
+void SkyClimber::Draw(aie::Renderer2D* renderer)
+{
+	m_physScene->Draw(renderer);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+// Counts heap allocations, reported by --replay runs
+// Steady state frames should report nothing, tests/SteadyStateAlloc.cpp checks they don't
+// #define DEBUG_ALLOCCOUNT
+
+#ifdef DEBUG_ALLOCCOUNT
+#include <atomic>
+#include <stddef.h>
+extern std::atomic<size_t> g_allocCount;
+#endif
+
+// Shows how many bodies were drawn & culled each frame
+// #define DEBUG_DRAWSTATS
+
+#include "PhysScene.h"
+
+#include "Barrier.h"
+#include "ChunkWorld.h"
+
+// Handy constants relating to window size
+constexpr static int WINDOW_WIDTH = 1280;
+constexpr static int WINDOW_HEIGHT = 720;
+constexpr static int WINDOW_WH = WINDOW_WIDTH / 2;
+constexpr static int WINDOW_HH = WINDOW_HEIGHT / 2;
+
+// The distance between the top of the screen & the ball.
+constexpr static int CAM_SPACING = 150;
+// Height at which the score text is fully opaque.
+constexpr static float CAM_SCOREOPACITYMAXHEIGHT = 1000;
+// Maximum size of the score text at the top of the screen
+constexpr static uint16_t CAM_MAXSCORETEXTSIZE = 30;
+
+// Spacing that determines the spawn region for obstacles
+constexpr static float OBS_MINSPAWNSPACING = 100.0f;
+constexpr static float OBS_MAXSPAWNSPACING = 300.0f;
+constexpr static float OBS_AVGSPAWNSPACING = (OBS_MINSPAWNSPACING + OBS_MAXSPAWNSPACING) / 2.0f;
+// Vertical spacing between obstacle spawn attempts within a chunk
+constexpr static float OBS_SLOTSPACING = 60.0f;
+// Lowest height obstacles can spawn at, keeps the starting screen clear
+constexpr static float OBS_MINSPAWNHEIGHT = WINDOW_HEIGHT + OBS_MINSPAWNSPACING;
+// Height at which the spawn chance maxes out
+constexpr static float OBS_MAXSPAWNHEIGHT = 20000.0f;
+// Spawn chance once the max spawn height has been reached
+constexpr static float OBS_MAXSPAWNCHANCE = 0.65f;
+
+// Height of each streamed world chunk
+constexpr static float CHK_HEIGHT = WINDOW_HH;
+// Distance above the screen that chunks are generated ahead of time
+constexpr static float CHK_LOADDISTANCE = OBS_MAXSPAWNSPACING;
+// Distance below the camera before chunks are frozen
+constexpr static float CHK_FREEZEDISTANCE = OBS_AVGSPAWNSPACING;
+// Frozen chunks kept below the camera before being evicted
+constexpr static uint32_t CHK_MAXFROZEN = 4;
+
+// Physics update time step
+constexpr static float SIM_TIMESTEP = 0.01f;
+
+// Everything the player did in a frame that affects the simulation
+struct ClimberInput
+{
+	float deltaTime = 0.0f;
+
+	// Barrier stroke committed this frame, in world space
+	// Points are owned by whoever filled in the input & only need to outlive the update
+	bool placeBarrier = false;
+	const vec2* barrierStroke = nullptr;
+	uint32_t barrierCount = 0;
+};
+
+// Sky Climber game simulation, kept free of windowing & input so it can also run headless
+class SkyClimber
+{
+public:
+	SkyClimber(uint32_t a_seed);
+	~SkyClimber();
+
+	void Update(const ClimberInput& input);
+	void Draw(aie::Renderer2D* renderer);
+
+	PhysScene* GetScene() { return m_physScene; }
+	Sphere* GetBall() { return m_ball; }
+
+	bool IsGameStarted() { return m_gameStart; }
+	bool IsGameOver() { return m_gameOver; }
+	bool HasBarrier() { return m_barrier != nullptr; }
+
+	float GetCamHeight() { return m_camHeight; }
+
+protected:
+	PhysScene*			m_physScene = nullptr;
+	ChunkWorld*			m_world = nullptr;
+
+	Sphere*				m_ball = nullptr;
+	Polygon*			m_wallLeft = nullptr;
+	Polygon*			m_wallRight = nullptr;
+	Barrier*			m_barrier = nullptr;
+
+	// Springy material for player drawn barriers
+	MaterialID			m_barrierMat = 0;
+
+	bool				m_gameStart = false;
+	bool				m_gameOver = false;
+
+	// Camera shifting functionality
+	float				m_camUpperBound = WINDOW_HH - CAM_SPACING;
+	float				m_camLowerBound = -WINDOW_HH + CAM_SPACING;
+	float				m_camHeight = 0;
+
+	float				m_camLowerDestroyBound = -WINDOW_HH - CAM_SPACING;
+};
\ No newline at end of file
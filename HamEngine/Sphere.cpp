@@ -1,9 +1,12 @@
 #include "Sphere.h"
 
-Sphere::Sphere(float a_radius, vec2 a_position, Material a_mat, Colour a_col, vec2 a_initVelocity) : Rigidbody(ShapeType::ST_SPHERE, a_position, a_initVelocity, a_mat, a_col)
+Sphere::Sphere(float a_radius, vec2 a_position, MaterialID a_mat, Colour a_col, vec2 a_initVelocity) : Rigidbody(ShapeType::ST_SPHERE, a_position, a_initVelocity, a_mat, a_col)
 {
 	m_radius = a_radius;
-	ComputeMass(a_mat.density);
+	m_boundingRadius = a_radius;
+	// Spin is only drawn, the shape itself never changes with it
+	m_hasOrient = false;
+	ComputeMass(materials::Get(a_mat).density);
 }
 
 void Sphere::Draw(aie::Renderer2D* renderer)
@@ -5,13 +5,15 @@
 class Sphere : public Rigidbody
 {
 public:
-	Sphere(float a_radius, vec2 a_position, Material a_mat, Colour a_col, vec2 a_initVelocity = vec2());
+	Sphere(float a_radius, vec2 a_position, MaterialID a_mat, Colour a_col, vec2 a_initVelocity = vec2());
 
 	virtual void Draw(aie::Renderer2D* renderer);
 
 	float GetRadius() { return m_radius; }
 
-	virtual void SetOrient(float radians) {}
+	// Core of a sphere is its centre, the radius is applied as rounding
+	virtual vec2 GetWorldSupport(const vec2& /*dir*/) { return m_position; }
+	virtual float GetSupportRadius() { return m_radius; }
 
 private:
 	virtual void ComputeMass(float density);
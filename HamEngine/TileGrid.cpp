@@ -0,0 +1,102 @@
+#include "TileGrid.h"
+
+#include <algorithm>
+
+void TileGrid::Build(Rigidbody* const* bodies, uint32_t count, float margin)
+{
+	m_bounds.resize(count);
+	m_queryStamps.resize(count, 0);
+	m_oversize.clear();
+
+	// Around two buckets per body keeps collisions between tiles rare
+	m_bucketCount = 64;
+	while (m_bucketCount < count * 2)
+		m_bucketCount <<= 1;
+	m_bucketStart.assign(m_bucketCount + 1, 0);
+
+	// Count each bucket's entries, offset by one so the prefix sum leaves each bucket's start
+	uint32_t entryCount = 0;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		float radius = bodies[i]->GetBoundingRadius() + margin;
+		AABB& bounds = m_bounds[i];
+		bounds.min = bodies[i]->GetPosition() - vec2(radius, radius);
+		bounds.max = bodies[i]->GetPosition() + vec2(radius, radius);
+
+		// Checked in floating point first, huge bodies would overflow the tile coordinates
+		vec2 span = (bounds.max - bounds.min) / m_tileSize + 1.0f;
+		if (span.x * span.y > (float)MaxBodyTiles)
+		{
+			m_oversize.push_back(i);
+			continue;
+		}
+
+		int32_t x0 = (int32_t)floor(bounds.min.x / m_tileSize), x1 = (int32_t)floor(bounds.max.x / m_tileSize);
+		int32_t y0 = (int32_t)floor(bounds.min.y / m_tileSize), y1 = (int32_t)floor(bounds.max.y / m_tileSize);
+		for (int32_t y = y0; y <= y1; ++y)
+			for (int32_t x = x0; x <= x1; ++x)
+				++m_bucketStart[GetBucket(x, y) + 1];
+		entryCount += (x1 - x0 + 1) * (y1 - y0 + 1);
+	}
+
+	for (uint32_t b = 0; b < m_bucketCount; ++b)
+		m_bucketStart[b + 1] += m_bucketStart[b];
+
+	// Fill in body order, so each bucket ends up ascending
+	m_entries.resize(entryCount);
+	for (uint32_t i = 0, next = 0; i < count; ++i)
+	{
+		if (next < m_oversize.size() && m_oversize[next] == i)
+		{
+			++next;
+			continue;
+		}
+
+		const AABB& bounds = m_bounds[i];
+		int32_t x0 = (int32_t)floor(bounds.min.x / m_tileSize), x1 = (int32_t)floor(bounds.max.x / m_tileSize);
+		int32_t y0 = (int32_t)floor(bounds.min.y / m_tileSize), y1 = (int32_t)floor(bounds.max.y / m_tileSize);
+		for (int32_t y = y0; y <= y1; ++y)
+			for (int32_t x = x0; x <= x1; ++x)
+				m_entries[m_bucketStart[GetBucket(x, y)]++] = i;
+	}
+
+	// Filling advanced each start to the next bucket's, shift them back
+	for (uint32_t b = m_bucketCount; b > 0; --b)
+		m_bucketStart[b] = m_bucketStart[b - 1];
+	m_bucketStart[0] = 0;
+}
+
+void TileGrid::FindPairs(std::vector<uint64_t>& pairs)
+{
+	pairs.clear();
+
+	for (uint32_t bucket = 0; bucket < m_bucketCount; ++bucket)
+	{
+		uint32_t first = m_bucketStart[bucket], last = m_bucketStart[bucket + 1];
+		for (uint32_t i = first; i < last; ++i)
+		{
+			uint32_t a = m_entries[i];
+			for (uint32_t j = i + 1; j < last; ++j)
+			{
+				uint32_t b = m_entries[j];
+				// Bodies spanning several tiles can land in a bucket more than once
+				if (a != b && Overlaps(m_bounds[a], m_bounds[b]))
+					pairs.push_back((uint64_t)a << 32 | b);
+			}
+		}
+	}
+
+	uint32_t count = GetBodyCount();
+	for (uint32_t a : m_oversize)
+	{
+		for (uint32_t b = 0; b < count; ++b)
+		{
+			if (a != b && Overlaps(m_bounds[a], m_bounds[b]))
+				pairs.push_back(a < b ? (uint64_t)a << 32 | b : (uint64_t)b << 32 | a);
+		}
+	}
+
+	// Pairs sharing several tiles, or both oversized, are found more than once
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
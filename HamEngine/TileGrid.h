@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Rigidbody.h"
+
+// Bodies covering more tiles than this are kept aside & tested against everything
+const uint32_t MaxBodyTiles = 16;
+
+// Broadphase bucketing bodies into square tiles by their bounds
+// Tiles are hashed into buckets, so the world needs no fixed size
+// Storage is kept between builds, so a scene of steady size never allocates
+class TileGrid
+{
+public:
+	TileGrid(float a_tileSize) : m_tileSize(a_tileSize) {}
+
+	// Buckets bodies by their bounding circle padded by margin
+	void Build(Rigidbody* const* bodies, uint32_t count, float margin);
+
+	// Every pair of bodies whose bounds overlap, as lower index << 32 | higher index in ascending order
+	void FindPairs(std::vector<uint64_t>& pairs);
+
+	// Calls func with the index of every body whose bounds overlap area, each once
+	template<typename Func>
+	void Query(const AABB& area, Func func);
+
+	uint32_t GetBodyCount() { return (uint32_t)m_bounds.size(); }
+
+private:
+	static bool Overlaps(const AABB& a, const AABB& b)
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+	}
+
+	uint32_t GetBucket(int32_t x, int32_t y)
+	{
+		return ((uint32_t)x * 73856093U ^ (uint32_t)y * 19349663U) & (m_bucketCount - 1);
+	}
+
+	float m_tileSize;
+	uint32_t m_bucketCount = 1;
+
+	std::vector<AABB> m_bounds;				// Padded bounds of each body
+	std::vector<uint32_t> m_bucketStart;	// First entry of each bucket, plus one past the end
+	std::vector<uint32_t> m_entries;		// Body indices grouped by bucket, ascending within each
+	std::vector<uint32_t> m_oversize;		// Bodies too large to bucket
+
+	// Marks bodies already reported by the current query
+	std::vector<uint32_t> m_queryStamps;
+	uint32_t m_queryStamp = 0;
+};
+
+template<typename Func>
+void TileGrid::Query(const AABB& area, Func func)
+{
+	uint32_t count = GetBodyCount();
+
+	// Areas spanning more tiles than there are bodies are cheaper to scan directly
+	vec2 tiles = (area.max - area.min) / m_tileSize;
+	if (tiles.x * tiles.y > (float)count)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+			if (Overlaps(m_bounds[i], area))
+				func(i);
+		return;
+	}
+
+	if (++m_queryStamp == 0)
+	{
+		std::fill(m_queryStamps.begin(), m_queryStamps.end(), 0);
+		m_queryStamp = 1;
+	}
+
+	int32_t x0 = (int32_t)floor(area.min.x / m_tileSize), x1 = (int32_t)floor(area.max.x / m_tileSize);
+	int32_t y0 = (int32_t)floor(area.min.y / m_tileSize), y1 = (int32_t)floor(area.max.y / m_tileSize);
+	for (int32_t y = y0; y <= y1; ++y)
+	{
+		for (int32_t x = x0; x <= x1; ++x)
+		{
+			// Buckets can hold other tiles' bodies too, so bounds are still checked
+			uint32_t bucket = GetBucket(x, y);
+			for (uint32_t e = m_bucketStart[bucket]; e < m_bucketStart[bucket + 1]; ++e)
+			{
+				uint32_t body = m_entries[e];
+				if (m_queryStamps[body] != m_queryStamp && Overlaps(m_bounds[body], area))
+				{
+					m_queryStamps[body] = m_queryStamp;
+					func(body);
+				}
+			}
+		}
+	}
+
+	for (uint32_t body : m_oversize)
+		if (Overlaps(m_bounds[body], area))
+			func(body);
+}
@@ -1,5 +1,7 @@
 #include "HamEngineApp.h"
 
+#include <cstring>
+
 // Enable leak detection
 // #define DEBUG_LEAKDETECT
 
@@ -11,13 +13,40 @@
 
 #endif // Leak Detection
 
+#ifdef DEBUG_ALLOCCOUNT
+
+#include <cstdlib>
+#include <new>
+
+std::atomic<size_t> g_allocCount(0);
+
+// Every other form of new & delete forwards to these
+void* operator new(size_t size)
+{
+	++g_allocCount;
+	if (void* memory = malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+#endif // Allocation counting
 
-int main() 
+
+int main(int argc, char* argv[]) 
 {
 #ifdef DEBUG_LEAKDETECT
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 #endif // Leak Detection
 
+	// Headless playback of a recorded session, e.g. HamEngine.exe --replay last.replay
+	if (argc > 2 && strcmp(argv[1], "--replay") == 0)
+		return RunReplay(argv[2]);
+
 	// allocation
 	auto app = new HamEngineApp();
 
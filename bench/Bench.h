@@ -0,0 +1,15 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Average time of one call to func over reps calls, in microseconds
+template<typename Func>
+double TimeAverage(int reps, Func func)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < reps; ++r)
+		func();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+}
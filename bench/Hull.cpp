@@ -0,0 +1,83 @@
+// PolygonShape::CreateHull on 10k point inputs, against the gift wrapping it replaced
+#include "Bench.h"
+#include "PolygonShape.h"
+#include "Random.h"
+
+#include <vector>
+
+const uint32_t HB_POINTS = 10000;
+const int HB_REPS = 20;
+
+// The old O(n*h) gift wrap without its 20 point cap, returning the hull size
+uint32_t GiftWrap(const vec2* points, uint32_t count, uint32_t* hull)
+{
+	uint32_t rightMost = 0;
+	for (uint32_t i = 1; i < count; ++i)
+		if (points[i].x > points[rightMost].x || (points[i].x == points[rightMost].x && points[i].y < points[rightMost].y))
+			rightMost = i;
+
+	uint32_t outCount = 0, index = rightMost;
+	for (;;)
+	{
+		hull[outCount] = index;
+		uint32_t next = 0;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (next == index)
+			{
+				next = i;
+				continue;
+			}
+			vec2 e1 = points[next] - points[hull[outCount]];
+			vec2 e2 = points[i] - points[hull[outCount]];
+			float c = cross(e1, e2);
+			if (c < 0.0f || (c == 0.0f && length2(e2) > length2(e1)))
+				next = i;
+		}
+		++outCount;
+		index = next;
+		if (next == rightMost || outCount >= count)
+			return outCount;
+	}
+}
+
+void Measure(const char* name, const std::vector<vec2>& points)
+{
+	const PolygonShape* shape = nullptr;
+	double hull = TimeAverage(HB_REPS, [&]()
+	{
+		if (shape)
+			shape->Release();
+		shape = PolygonShape::CreateHull(points.data(), (uint32_t)points.size());
+		shape->AddRef();
+	});
+
+	// Gift wrapping is quadratic on inputs that are all hull, so those only run once
+	std::vector<uint32_t> indices(points.size());
+	uint32_t giftCount = 0;
+	int giftReps = GiftWrap(points.data(), (uint32_t)points.size(), indices.data()) > 1000 ? 1 : HB_REPS;
+	double gift = TimeAverage(giftReps, [&]() { giftCount = GiftWrap(points.data(), (uint32_t)points.size(), indices.data()); });
+
+	printf("%-13s monotone chain & simplify %8.3f ms -> %2u corners | gift wrap %9.3f ms -> %5u corners\n",
+		name, hull / 1000.0, shape->vertexCount, gift / 1000.0, giftCount);
+	shape->Release();
+}
+
+int main()
+{
+	hamh::Rng rng(7);
+	std::vector<vec2> cloud(HB_POINTS), circle(HB_POINTS), sketch(HB_POINTS);
+	for (uint32_t i = 0; i < HB_POINTS; ++i)
+	{
+		float angle = 6.2831853f * i / HB_POINTS;
+		cloud[i] = vec2(rng.fRandRange(-100, 100), rng.fRandRange(-100, 100));
+		circle[i] = vec2(cos(angle), sin(angle)) * 100.0f;
+		// Noisy tracing of an ellipse, like a mouse sketch
+		sketch[i] = vec2(120 * cos(angle), 60 * sin(angle)) + vec2(rng.fRandRange(-2, 2), rng.fRandRange(-2, 2));
+	}
+
+	Measure("square cloud", cloud);
+	Measure("circle", circle);
+	Measure("sketch", sketch);
+	return 0;
+}
@@ -0,0 +1,90 @@
+// Dedicated narrowphase routines against the generic GJK/EPA path, per shape pair
+// Decides which pairs GetCollider keeps a dedicated routine for
+#include "Bench.h"
+#include "Manifold.h"
+#include "Random.h"
+
+#include <vector>
+
+const uint32_t NP_PAIRS = 2000;
+const int NP_REPS = 50;
+
+hamh::Rng g_rng(3);
+MaterialID g_mat;
+
+Rigidbody* RandomBody(ShapeType shape, vec2 position)
+{
+	switch (shape)
+	{
+	case ShapeType::ST_SPHERE:
+		return new Sphere(g_rng.fRandRange(5, 20), position, g_mat, Colour(1, 0, 0));
+	case ShapeType::ST_LINE:
+	{
+		float angle = g_rng.fRandRange(0, 6.283f);
+		return new Line(position, position + vec2(cos(angle), sin(angle)) * 60.0f, g_mat, Colour(1, 1, 1));
+	}
+	default:
+	{
+		// Random point cloud, hull of 3 to 19 corners
+		vec2 points[20];
+		uint32_t count = 3 + g_rng.RandRange(0, 17);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			float angle = g_rng.fRandRange(0, 6.283f), radius = g_rng.fRandRange(5, 30);
+			points[i] = vec2(cos(angle), sin(angle)) * radius;
+		}
+		return new Polygon(points, count, position, g_mat, Colour(1, 1, 1), vec2(), g_rng.fRandRange(0, 6.283f));
+	}
+	}
+}
+
+void Compare(const char* name, ShapeType shapeA, ShapeType shapeB)
+{
+	// Placed close enough that most pairs overlap, as they would after the broadphase
+	std::vector<Rigidbody*> bodies;
+	for (uint32_t i = 0; i < NP_PAIRS; ++i)
+	{
+		bodies.push_back(RandomBody(shapeA, vec2()));
+		bodies.push_back(RandomBody(shapeB, vec2(g_rng.fRandRange(-40, 40), g_rng.fRandRange(-40, 40))));
+	}
+
+	fn dedicated = GetCollider(ShapePairIndex(shapeA, shapeB));
+	uint32_t dedicatedHits = 0, genericHits = 0;
+
+	double dedicatedTime = TimeAverage(NP_REPS, [&]()
+	{
+		for (uint32_t i = 0; i < NP_PAIRS; ++i)
+		{
+			Manifold m;
+			dedicatedHits += dedicated(&m, bodies[i * 2], bodies[i * 2 + 1]);
+		}
+	});
+
+	double genericTime = TimeAverage(NP_REPS, [&]()
+	{
+		for (uint32_t i = 0; i < NP_PAIRS; ++i)
+		{
+			Manifold m;
+			genericHits += Manifold::convex2Convex(&m, bodies[i * 2], bodies[i * 2 + 1]);
+		}
+	});
+
+	printf("%-16s dedicated %7.1f ns/pair (%5u hits) | GJK/EPA %7.1f ns/pair (%5u hits)\n", name,
+		dedicatedTime * 1000.0 / NP_PAIRS, dedicatedHits / NP_REPS, genericTime * 1000.0 / NP_PAIRS, genericHits / NP_REPS);
+
+	for (Rigidbody* body : bodies)
+		delete body;
+}
+
+int main()
+{
+	g_mat = materials::Register(Material());
+
+	Compare("sphere/sphere", ShapeType::ST_SPHERE, ShapeType::ST_SPHERE);
+	Compare("sphere/polygon", ShapeType::ST_SPHERE, ShapeType::ST_POLYGON);
+	Compare("polygon/sphere", ShapeType::ST_POLYGON, ShapeType::ST_SPHERE);
+	Compare("polygon/polygon", ShapeType::ST_POLYGON, ShapeType::ST_POLYGON);
+	Compare("sphere/line", ShapeType::ST_SPHERE, ShapeType::ST_LINE);
+	Compare("line/sphere", ShapeType::ST_LINE, ShapeType::ST_SPHERE);
+	return 0;
+}
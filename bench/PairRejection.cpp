@@ -0,0 +1,55 @@
+// Throughput of pairs rejected before narrowphase, against sending every pair through the collider table
+#include "Bench.h"
+#include "Manifold.h"
+
+#include <vector>
+
+const uint32_t PR_BODIES = 1000;
+const float PR_SPACING = 100.0f;
+const int PR_REPS = 10;
+
+int main()
+{
+	// Spheres & polygons on a grid, far enough apart that no pair touches
+	MaterialID mat = materials::Register(Material());
+	std::vector<Rigidbody*> bodies;
+	for (uint32_t i = 0; i < PR_BODIES; ++i)
+	{
+		vec2 position(i % 32 * PR_SPACING, i / 32 * PR_SPACING);
+		if (i % 2)
+			bodies.push_back(new Sphere(10.0f + i % 7, position, mat, Colour(1, 0, 0)));
+		else
+			bodies.push_back(new Polygon(8.0f + i % 5, 8.0f + i % 3, position, mat, Colour(1, 1, 1), vec2(), 0.3f * i));
+	}
+
+	uint32_t pairCount = PR_BODIES * (PR_BODIES - 1) / 2;
+	uint32_t hits = 0;
+
+	double early = TimeAverage(PR_REPS, [&]()
+	{
+		for (uint32_t a = 0; a < PR_BODIES; ++a)
+			for (uint32_t b = a + 1; b < PR_BODIES; ++b)
+			{
+				Manifold m;
+				hits += m.Solve(bodies[a], bodies[b]);
+			}
+	});
+
+	double full = TimeAverage(PR_REPS, [&]()
+	{
+		for (uint32_t a = 0; a < PR_BODIES; ++a)
+			for (uint32_t b = a + 1; b < PR_BODIES; ++b)
+			{
+				Manifold m;
+				hits += GetCollider(ShapePairIndex(bodies[a]->GetShape(), bodies[b]->GetShape()))(&m, bodies[a], bodies[b]);
+			}
+	});
+
+	printf("%u pairs, %u hits (expect 0)\n", pairCount, hits);
+	printf("bounding circle early-out: %6.2f ns/pair, %7.1f M pairs/s\n", early * 1000.0 / pairCount, pairCount / early);
+	printf("narrowphase only:          %6.2f ns/pair, %7.1f M pairs/s\n", full * 1000.0 / pairCount, pairCount / full);
+
+	for (Rigidbody* body : bodies)
+		delete body;
+	return 0;
+}
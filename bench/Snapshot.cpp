@@ -0,0 +1,62 @@
+// Cost of PhysScene::Snapshot & Restore each step, at 1k & 10k bodies
+#include "Bench.h"
+#include "PhysScene.h"
+
+const int SN_REPS = 2000;
+
+void Measure(uint32_t count)
+{
+	PhysScene scene(0.01f, vec2(0, -100), 3);
+	MaterialID mat = materials::Register(Material(1.2f, 0.3f));
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		vec2 position(i % 100 * 20.0f, i / 100 * 20.0f);
+		if (i % 2)
+			scene.AddBody(new Sphere(5, position, mat, Colour(1, 0, 0), vec2(1, 2)));
+		else
+			scene.AddBody(new Polygon(5, 5, position, mat, Colour(1, 1, 1), vec2(3, 1), 0.1f * i));
+	}
+
+	// First snapshot sizes the blob, later ones reuse it
+	std::vector<uint8_t> blob;
+	scene.Snapshot(blob);
+
+	double snapshot = TimeAverage(SN_REPS, [&]() { scene.Snapshot(blob); });
+	double restore = TimeAverage(SN_REPS, [&]() { scene.Restore(blob); });
+
+	printf("%5u bodies: blob %7zu bytes, snapshot %7.1f us, restore %7.1f us\n", count, blob.size(), snapshot, restore);
+}
+
+// Rolling back & replaying the same steps must land on the same state
+bool CheckRollback()
+{
+	PhysScene scene(0.01f, vec2(0, -100), 9);
+	scene.AddBody(new Polygon(600, 20, vec2(640, 0), materials::Register(Material(0.0f, 0.5f)), Colour(1, 1, 1)));
+	for (int i = 0; i < 30; ++i)
+		scene.AddBody(new Polygon(8, 8, vec2(100 + 20 * i, 60 + 25 * (i % 4)), materials::Register(Material(1.2f, 0.3f)), Colour(1, 1, 1), vec2(), 0.3f * i));
+
+	for (int s = 0; s < 100; ++s)
+		scene.Update(0.013f);
+
+	std::vector<uint8_t> blob;
+	scene.Snapshot(blob);
+	for (int s = 0; s < 300; ++s)
+		scene.Update(0.013f);
+	uint64_t expected = scene.Checksum();
+
+	if (!scene.Restore(blob))
+		return false;
+	for (int s = 0; s < 300; ++s)
+		scene.Update(0.013f);
+	return scene.Checksum() == expected;
+}
+
+int main()
+{
+	Measure(1000);
+	Measure(10000);
+
+	bool rollback = CheckRollback();
+	printf("rollback %s\n", rollback ? "matches" : "DIFFERS");
+	return rollback ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+// Sub-stepping against shrinking the time step, on a settling pile of boxes
+// Each pair of runs covers the same simulated time with the same number of solver passes
+#include "Bench.h"
+#include "PhysScene.h"
+
+const int SS_FRAMES = 600;
+const uint32_t SS_BOXES = 400;
+
+void Run(const char* name, float timeStep, uint32_t subSteps, int stepsPerFrame)
+{
+	PhysScene scene(timeStep, vec2(0, -400));
+	scene.SetSubSteps(subSteps);
+
+	MaterialID ground = materials::Register(Material(0.0f, 0.1f));
+	MaterialID box = materials::Register(Material(1.2f, 0.1f));
+	scene.AddBody(new Polygon(400, 20, vec2(400, 0), ground, Colour(1, 1, 1)));
+	scene.AddBody(new Polygon(20, 400, vec2(-20, 400), ground, Colour(1, 1, 1)));
+	scene.AddBody(new Polygon(20, 400, vec2(820, 400), ground, Colour(1, 1, 1)));
+	for (uint32_t i = 0; i < SS_BOXES; ++i)
+		scene.AddBody(new Polygon(9, 9, vec2(20 + 19 * (i % 40), 40 + 19 * (i / 40)), box, Colour(1, 1, 1)));
+
+	double frame = TimeAverage(SS_FRAMES, [&]()
+	{
+		for (int s = 0; s < stepsPerFrame; ++s)
+			scene.TimeStep();
+	});
+
+	// How well the pile settled, residual motion & boxes pushed through the floor
+	float meanSpeed = 0.0f, averageY = 0.0f;
+	uint32_t escaped = 0;
+	for (size_t i = 3; i < scene.GetBodyCount(); ++i)
+	{
+		Rigidbody* body = scene.GetBody(i);
+		meanSpeed += length(body->GetVelocity()) / SS_BOXES;
+		averageY += body->GetPosition().y / SS_BOXES;
+		if (body->GetPosition().y < 20)
+			++escaped;
+	}
+
+	printf("%-18s %7.3f ms/frame  mean speed %6.2f  avg y %7.2f  escaped %u\n", name, frame / 1000.0, meanSpeed, averageY, escaped);
+}
+
+int main()
+{
+	Run("1/30 step", 1 / 30.0f, 1, 1);
+	Run("1/30 step, 4 sub", 1 / 30.0f, 4, 1);
+	Run("1/120 step", 1 / 120.0f, 1, 4);
+	Run("1/60 step", 1 / 60.0f, 1, 1);
+	Run("1/60 step, 4 sub", 1 / 60.0f, 4, 1);
+	Run("1/240 step", 1 / 240.0f, 1, 4);
+	return 0;
+}
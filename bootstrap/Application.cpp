@@ -107,6 +107,9 @@ void Application::run(const char* title, int width, int height, bool fullscreen)
 			// clear imgui
 			ImGui_NewFrame();
 
+			// release last frame's scratch memory
+			m_frameArena.reset();
+
 			update(float(deltaTime));
 
 			draw();
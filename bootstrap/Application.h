@@ -1,5 +1,7 @@
 #pragma once
 
+#include "LinearArena.h"
+
 // forward declared structure for access to GLFW window
 struct GLFWwindow;
 
@@ -55,6 +57,9 @@ public:
 	// returns time since application started
 	float getTime() const;
 
+	// scratch memory for the current frame, released before the next update()
+	LinearArena& getFrameArena() { return m_frameArena; }
+
 protected:
 
 	virtual bool createWindow(const char* title, int width, int height, bool fullscreen);
@@ -67,6 +72,8 @@ protected:
 	
 	unsigned int	m_fps;
 
+	LinearArena		m_frameArena;
+
 };
 
 } // namespace aie
\ No newline at end of file
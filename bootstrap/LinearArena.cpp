@@ -0,0 +1,64 @@
+#include "LinearArena.h"
+#include <cstdint>
+
+namespace aie {
+
+LinearArena::LinearArena(size_t capacity)
+	: m_memory(nullptr),
+	m_capacity(capacity),
+	m_used(0),
+	m_overflowUsed(0),
+	m_highWater(0) {
+	if (m_capacity > 0)
+		m_memory = (unsigned char*)::operator new(m_capacity);
+}
+
+LinearArena::~LinearArena() {
+	for (void* block : m_overflow)
+		::operator delete(block);
+	::operator delete(m_memory);
+}
+
+void* LinearArena::allocate(size_t size, size_t alignment) {
+
+	// alignment must be a power of two
+	uintptr_t base = (uintptr_t)m_memory;
+	uintptr_t aligned = (base + m_used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	size_t end = (size_t)(aligned - base) + size;
+
+	void* result = nullptr;
+	if (m_memory != nullptr && end <= m_capacity) {
+		m_used = end;
+		result = (void*)aligned;
+	}
+	else {
+		// over-allocate so the block can be aligned by hand
+		void* block = ::operator new(size + alignment);
+		m_overflow.push_back(block);
+		m_overflowUsed += size + alignment;
+		result = (void*)(((uintptr_t)block + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	}
+
+	if (getUsed() > m_highWater)
+		m_highWater = getUsed();
+	return result;
+}
+
+void LinearArena::reset() {
+
+	if (!m_overflow.empty()) {
+		for (void* block : m_overflow)
+			::operator delete(block);
+		m_overflow.clear();
+
+		// grow with headroom so a slowly rising peak doesn't regrow every time
+		::operator delete(m_memory);
+		m_capacity = m_highWater + m_highWater / 2;
+		m_memory = (unsigned char*)::operator new(m_capacity);
+	}
+
+	m_used = 0;
+	m_overflowUsed = 0;
+}
+
+} // namespace aie
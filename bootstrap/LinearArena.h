@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace aie {
+
+// bump allocator for transient data. allocations are never freed individually,
+// instead reset() releases everything at once, ready for the next step or frame
+class LinearArena {
+public:
+
+	LinearArena(size_t capacity = 0);
+	~LinearArena();
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	// returns aligned memory that stays valid until the next reset()
+	void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// uninitialised array, limited to types that need no destructor
+	template <typename T>
+	T* allocateArray(size_t count) {
+		static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destructed");
+		return count ? (T*)allocate(count * sizeof(T), alignof(T)) : nullptr;
+	}
+
+	// O(1) release of every allocation. if the arena overflowed since the last reset
+	// it regrows to the high-water mark, so steady state use never touches the heap
+	void reset();
+
+	// bytes in use since the last reset, including overflow
+	size_t getUsed() const { return m_used + m_overflowUsed; }
+	size_t getCapacity() const { return m_capacity; }
+	// most bytes ever in use between two resets
+	size_t getHighWater() const { return m_highWater; }
+
+protected:
+
+	unsigned char*		m_memory;
+	size_t				m_capacity;
+	size_t				m_used;
+
+	// requests that didn't fit are served by the heap until the next reset
+	std::vector<void*>	m_overflow;
+	size_t				m_overflowUsed;
+
+	size_t				m_highWater;
+};
+
+} // namespace aie
@@ -0,0 +1,58 @@
+// A drawn barrier must disappear the first time the ball bounces off it
+// Build alongside the engine sources, see README.md
+#include "SkyClimber.h"
+
+#include <cstdio>
+
+const int BH_MAXFRAMES = 600;
+
+int main()
+{
+	SkyClimber game(1);
+	vec2 ballStart = game.GetBall()->GetPosition();
+
+	// Flat stroke well under the ball, replacing the starter platform
+	vec2 stroke[2] = { ballStart + vec2(-150, -200), ballStart + vec2(150, -200) };
+	ClimberInput input;
+	input.deltaTime = 1.0f / 60.0f;
+	input.placeBarrier = true;
+	input.barrierStroke = stroke;
+	input.barrierCount = 2;
+	game.Update(input);
+	input.placeBarrier = false;
+
+	if (!game.HasBarrier())
+	{
+		printf("FAIL: barrier removed before the ball reached it\n");
+		return 1;
+	}
+
+	float fallSpeed = 0.0f;
+	for (int frame = 1; frame < BH_MAXFRAMES && !game.IsGameOver(); ++frame)
+	{
+		float velocityY = game.GetBall()->GetVelocity().y;
+		fallSpeed = min(fallSpeed, velocityY);
+
+		// Rising again after falling, the first bounce has happened
+		if (fallSpeed < 0.0f && velocityY > 0.0f)
+		{
+			if (game.HasBarrier())
+			{
+				printf("FAIL: ball bounced at %.1f & the barrier survived\n", fallSpeed);
+				return 1;
+			}
+			printf("PASS: barrier removed by the first bounce at %.1f\n", fallSpeed);
+			return 0;
+		}
+
+		if (!game.HasBarrier() && fallSpeed > -1.0f)
+		{
+			printf("FAIL: barrier removed before the ball fell onto it\n");
+			return 1;
+		}
+		game.Update(input);
+	}
+
+	printf("FAIL: ball never bounced\n");
+	return 1;
+}
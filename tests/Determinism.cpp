@@ -0,0 +1,58 @@
+// Lockstep regression, a fixed scene stepped 100k times must always land on the same state
+// Build alongside the engine sources with HAMH_DETERMINISTIC defined, at any optimisation level
+// e.g. g++ -std=c++14 -O2 -DHAMH_DETERMINISTIC -I HamEngine -I bootstrap -I dependencies/glm <engine & bootstrap sources> tests/Determinism.cpp
+#include "PhysScene.h"
+
+#include <cstdio>
+
+#ifndef HAMH_DETERMINISTIC
+#error The expected checksum only holds with HAMH_DETERMINISTIC defined
+#endif
+
+// Update when a change to the solver is meant to alter the simulation
+const uint64_t DET_EXPECTED = 0xed2f1a761fa1b4c8ULL;
+const int DET_STEPS = 100000;
+
+uint64_t RunScene()
+{
+	PhysScene scene(0.01f, vec2(0, -100), 7);
+	scene.AddBody(new Polygon(600, 20, vec2(640, 0), materials::Register(Material(0.0f, 0.5f)), Colour(1, 1, 1)));
+	for (int i = 0; i < 40; ++i)
+	{
+		float x = 100 + 25 * i + scene.GetRng().fRand() * 5;
+		if (i % 2)
+			scene.AddBody(new Sphere(10.0f + i % 7, vec2(x, 100 + 30 * (i % 5)), materials::Register(Material(1.2f, 0.3f)), Colour(1, 0, 0)));
+		else
+			scene.AddBody(new Polygon(8.0f + i % 5, 8.0f + i % 3, vec2(x, 120 + 30 * (i % 5)), materials::Register(Material(1.2f, 0.3f)), Colour(1, 1, 1), vec2(), 0.3f * i));
+	}
+
+	for (int s = 0; s < DET_STEPS; ++s)
+	{
+		// Kick a random body now & then, so the pile never settles into sleep
+		if (s % 5000 == 0)
+			scene.GetBody(1 + scene.GetRng().RandRange(0, 40))->AddVelocity(vec2(0, 300));
+		scene.TimeStep();
+	}
+
+	return scene.Checksum();
+}
+
+int main()
+{
+	uint64_t first = RunScene();
+	uint64_t second = RunScene();
+	printf("checksum %016llx, expected %016llx\n", (unsigned long long)first, (unsigned long long)DET_EXPECTED);
+
+	if (first != second)
+	{
+		printf("FAIL: two runs in the same process disagree (%016llx)\n", (unsigned long long)second);
+		return 1;
+	}
+	if (first != DET_EXPECTED)
+	{
+		printf("FAIL: simulation no longer matches the recorded state\n");
+		return 1;
+	}
+	printf("PASS\n");
+	return 0;
+}
@@ -0,0 +1,44 @@
+// Drawing must visit everything by default, & only bodies in view once a view size is set
+// Build alongside the engine sources, see README.md
+#include "PhysScene.h"
+
+#include <cstdio>
+
+int main()
+{
+	PhysScene scene(0.01f, vec2(0, -100));
+	MaterialID mat = materials::Register(Material(0.0f, 0.5f));
+
+	// A 9 x 9 grid of static spheres centred on the origin, so some lie on every side of the camera
+	for (int y = -4; y <= 4; ++y)
+		for (int x = -4; x <= 4; ++x)
+			scene.AddBody(new Sphere(5, vec2(x * 200.0f, y * 200.0f), mat, Colour(1, 1, 1)));
+	uint32_t total = (uint32_t)scene.GetBodyCount();
+
+	uint32_t visited = 0;
+	scene.QueryView(vec2(0, 0), [&](uint32_t) { ++visited; });
+	if (visited != total)
+	{
+		printf("FAIL: default view visited %u of %u bodies\n", visited, total);
+		return 1;
+	}
+
+	// A 500 x 300 view from the origin holds the spheres at x 0..400 & y 0..200
+	scene.SetViewSize(vec2(500, 300));
+	visited = 0;
+	bool outside = false;
+	scene.QueryView(vec2(0, 0), [&](uint32_t index)
+	{
+		vec2 position = scene.GetBody(index)->GetPosition();
+		outside |= position.x < -5 || position.x > 505 || position.y < -5 || position.y > 305;
+		++visited;
+	});
+	if (visited != 6 || outside)
+	{
+		printf("FAIL: sized view visited %u bodies, expected 6%s\n", visited, outside ? ", some out of view" : "");
+		return 1;
+	}
+
+	printf("PASS: %u of %u bodies drawn by default, %u in view\n", total, total, visited);
+	return 0;
+}
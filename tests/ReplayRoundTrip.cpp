@@ -0,0 +1,83 @@
+// Recorded sessions must play back frame for frame, including single click strokes
+// Build alongside the engine sources, see README.md
+#include "Replay.h"
+
+#include <cstdio>
+
+const char* RT_PATH = "roundtrip.replay";
+const uint32_t RT_SEED = 42;
+const int RT_FRAMES = 300;
+
+// Frame's input, with a single click on frame 30 & a drawn line on frame 120
+ClimberInput MakeInput(int frame, float camHeight, vec2* stroke)
+{
+	ClimberInput input;
+	input.deltaTime = 1.0f / 60.0f;
+
+	if (frame == 30)
+	{
+		stroke[0] = vec2(WINDOW_WH, camHeight + WINDOW_HH - 100);
+		input.placeBarrier = true;
+		input.barrierStroke = stroke;
+		input.barrierCount = 1;
+	}
+	else if (frame == 120)
+	{
+		for (uint32_t i = 0; i < 50; ++i)
+			stroke[i] = vec2(WINDOW_WH - 100 + i * 4.0f, camHeight + WINDOW_HH - 150);
+		input.placeBarrier = true;
+		input.barrierStroke = stroke;
+		input.barrierCount = 50;
+	}
+	return input;
+}
+
+int main()
+{
+	vec2 stroke[50];
+
+	SkyClimber live(RT_SEED);
+	ReplayRecorder recorder;
+	if (!recorder.Open(RT_PATH, RT_SEED))
+	{
+		printf("FAIL: couldn't write %s\n", RT_PATH);
+		return 1;
+	}
+	for (int frame = 0; frame < RT_FRAMES; ++frame)
+	{
+		ClimberInput input = MakeInput(frame, live.GetCamHeight(), stroke);
+		live.Update(input);
+		recorder.Record(input);
+	}
+	recorder.Close();
+
+	SkyClimber replayed(RT_SEED);
+	ReplayPlayer player;
+	if (!player.Open(RT_PATH))
+	{
+		printf("FAIL: couldn't read %s back\n", RT_PATH);
+		return 1;
+	}
+
+	int frames = 0;
+	ClimberInput input;
+	while (player.Next(input))
+	{
+		replayed.Update(input);
+		++frames;
+	}
+	bool corrupt = player.IsCorrupt();
+	remove(RT_PATH);
+
+	uint64_t expected = live.GetScene()->Checksum();
+	uint64_t actual = replayed.GetScene()->Checksum();
+	printf("%d of %d frames, checksum %016llx, expected %016llx\n", frames, RT_FRAMES, (unsigned long long)actual, (unsigned long long)expected);
+
+	if (corrupt || frames != RT_FRAMES || actual != expected)
+	{
+		printf("FAIL: replay doesn't match the recorded session\n");
+		return 1;
+	}
+	printf("PASS\n");
+	return 0;
+}
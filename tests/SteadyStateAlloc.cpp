@@ -0,0 +1,64 @@
+// Once warmed up, game frames without new input must not touch the heap
+// Build alongside the engine sources, see README.md
+#include "SkyClimber.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+const int SA_WARMUPFRAMES = 600;
+const int SA_FRAMES = 600;
+
+std::atomic<size_t> g_testAllocs(0);
+
+// Every other form of new & delete forwards to these
+void* operator new(size_t size)
+{
+	++g_testAllocs;
+	if (void* memory = malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+int main()
+{
+	SkyClimber game(7);
+	if (g_testAllocs == 0)
+	{
+		printf("FAIL: operator new isn't being counted\n");
+		return 1;
+	}
+
+	// Until the player draws, the ball keeps bouncing on the starter platform
+	ClimberInput input;
+	input.deltaTime = 1.0f / 60.0f;
+
+	// Storage grows to fit the scene over the first frames
+	for (int frame = 0; frame < SA_WARMUPFRAMES && !game.IsGameOver(); ++frame)
+		game.Update(input);
+
+	size_t before = g_testAllocs;
+	int frames = 0;
+	for (; frames < SA_FRAMES && !game.IsGameOver(); ++frames)
+		game.Update(input);
+	size_t allocs = g_testAllocs - before;
+
+	if (frames == 0)
+	{
+		printf("FAIL: game ended during warm up\n");
+		return 1;
+	}
+	if (allocs != 0)
+	{
+		printf("FAIL: %zu allocations over %d steady frames\n", allocs, frames);
+		return 1;
+	}
+	printf("PASS: no allocations over %d steady frames\n", frames);
+	return 0;
+}